@@ -7,6 +7,8 @@
 #include "utility/create.h"
 #include "device/queue.h"
 #include "object/camera/main_camera.h"
+#include "utility/profiler.h"
+#include "utility/trace.h"
 
 namespace painting
 {
@@ -206,6 +208,28 @@ namespace painting
         {
             auto [buffer, memory, data, rowpitch] = object_[0]->map_read_image_memory();
 
+            if (!options_.checkpoint_file.empty())
+            {
+                // resume the same target and config, then keep saving
+                if (picture_->load_checkpoint(options_.checkpoint_file, data))
+                {
+                    std::cout << "resumed from " << options_.checkpoint_file << "\n";
+                }
+                picture_->set_checkpoint(options_.checkpoint_file, options_.checkpoint_interval);
+            }
+            if (!options_.snapshot_prefix.empty())
+            {
+                picture_->set_snapshot(options_.snapshot_prefix, ".png", options_.snapshot_interval);
+            }
+            if (!options_.timelapse_file.empty())
+            {
+                picture_->set_timelapse(options_.timelapse_file, options_.timelapse_interval, 10);
+            }
+
+            if (!options_.profile_file.empty())
+            {
+                vkcpp::Profiler::getInstance()->open(options_.profile_file);
+            }
             auto current_time = std::chrono::high_resolution_clock::now();
             while (!vkcpp::MainWindow::getInstance()->should_close())
             {
@@ -221,8 +245,23 @@ namespace painting
 
                 draw_frame();
             }
+            vkDeviceWaitIdle(*device_);
+
+            if (!options_.export_prefix.empty())
+            {
+                const StrokeLog &stroke_log = picture_->get_stroke_log();
+                const VkExtent3D &picture_extent = picture_->get_extent_3d();
+                stroke_log.export_json(options_.export_prefix + ".json", picture_extent);
+                stroke_log.export_svg(options_.export_prefix + ".svg",
+                                      picture_extent,
+                                      picture_->get_mutable_brushes().get_texture_files(),
+                                      picture_->get_mutable_brushes().get_region_half_extents());
+                std::string replay_file = options_.export_prefix + "_replay.png";
+                picture_->replay({picture_extent.width * 2, picture_extent.height * 2, 1}, replay_file.c_str());
+            }
 
             picture_.reset();
+            vkcpp::Profiler::getInstance()->close();
             object_[0]->unmap_buffer_memory(buffer, memory);
         }
     }
@@ -252,6 +291,8 @@ namespace painting
         instance_.reset();
 
         vkcpp::MainWindow::getInstance()->destroy_window();
+
+        VKCPP_TRACE_DUMP("trace.json");
     }
 
     void PaintingApplication::cleanup_swapchain()
@@ -346,7 +387,7 @@ namespace painting
                 app->object_.back()->init_transform({-width / 2.0f, 0.0f, 0.0f});
                 int size = app->swapchain_->get_image_views().size();
 
-                app->picture_ = std::make_unique<Picture>(app->device_.get(), app->command_pool_.get(), app->render_stage_.get(), extent, size, 12u, 3u, 2u);
+                app->picture_ = std::make_unique<Picture>(app->device_.get(), app->command_pool_.get(), app->render_stage_.get(), extent, size, 12u, 3u, 2u, 2u);
                 app->recreate_swapchain();
             }
             else
@@ -27,6 +27,27 @@ namespace painting
     struct input
     {
     };
+
+    /**
+     *  optional outputs of the window app, every one is off by default
+     */
+    struct ApplicationOptions
+    {
+        // resumed from if it exists, written every checkpoint_interval runs
+        std::string checkpoint_file;
+        uint32_t checkpoint_interval{0};
+        // prefix + run count + .png every snapshot_interval runs
+        std::string snapshot_prefix;
+        uint32_t snapshot_interval{0};
+        // one frame every timelapse_interval accepted generations
+        std::string timelapse_file;
+        uint32_t timelapse_interval{0};
+        // on exit : prefix.json, prefix.svg (stroke log) and prefix_replay.png (2x)
+        std::string export_prefix;
+        // per generation breakdown (jsonl)
+        std::string profile_file;
+    }; // struct ApplicationOptions
+
     class PaintingApplication
     {
         const uint32_t MAX_FRAMES_IN_FLIGHT = 3;
@@ -45,9 +66,12 @@ namespace painting
         };
 
         PaintingApplication() = default;
+        explicit PaintingApplication(const ApplicationOptions &options) : options_(options) {}
         void run(uint32_t width = 512, uint32_t height = 512, std::string title = "painting");
 
     private:
+        ApplicationOptions options_;
+
         std::unique_ptr<vkcpp::Instance> instance_{nullptr};
         std::unique_ptr<vkcpp::Surface> surface_{nullptr};
         std::unique_ptr<vkcpp::Device> device_{nullptr};
@@ -0,0 +1,190 @@
+#include "batch_runner.h"
+
+#include "device/physical_device.h"
+#include "stb/stb_image.h"
+#include "utility/trace.h"
+
+#include <sstream>
+
+namespace painting
+{
+    BatchRunner::BatchRunner(const std::string &manifest, uint32_t worker_count)
+        : jobs_(readManifest(manifest)), worker_count_(std::max(worker_count, 1u))
+    {
+        instance_ = std::make_unique<vkcpp::Instance>(true);
+        instance_->query_gpus(nullptr);
+        std::vector<const char *> device_extensions;
+        vkcpp::PhysicalDevice *gpu = instance_->get_suitable_gpu(device_extensions);
+        device_ = std::make_unique<vkcpp::Device>(gpu);
+    }
+
+    BatchRunner::~BatchRunner()
+    {
+        if (device_)
+        {
+            vkDeviceWaitIdle(*device_);
+        }
+        device_.reset();
+        instance_.reset();
+    }
+
+    std::vector<BatchJob> BatchRunner::readManifest(const std::string &filename)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("failed to open batch manifest: " + filename);
+        }
+        std::vector<BatchJob> jobs;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            size_t comment = line.find('#');
+            if (comment != std::string::npos)
+            {
+                line.erase(comment);
+            }
+            std::istringstream stream(line);
+            BatchJob job;
+            if (parseJob(stream, job))
+            {
+                jobs.push_back(job);
+            }
+        }
+        return jobs;
+    }
+
+    bool BatchRunner::parseJob(std::istream &stream, BatchJob &job)
+    {
+        if (!(stream >> job.target >> job.output >> job.run_count))
+        {
+            return false;
+        }
+        // optional fields keep their defaults
+        uint32_t *fields[] = {&job.population_size, &job.brush_count, &job.strip_count, &job.island_count};
+        for (uint32_t *field : fields)
+        {
+            uint32_t value;
+            if (!(stream >> value))
+            {
+                break;
+            }
+            *field = value;
+        }
+        return true;
+    }
+
+    std::vector<char> BatchRunner::loadTarget(const std::string &filename, VkExtent3D &extent)
+    {
+        int width, height, channels;
+        stbi_uc *pixels = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        if (!pixels)
+        {
+            throw std::runtime_error("failed to load target image: " + filename);
+        }
+        std::vector<char> data(reinterpret_cast<const char *>(pixels), reinterpret_cast<const char *>(pixels) + width * height * 4);
+        stbi_image_free(pixels);
+        extent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1};
+        return data;
+    }
+
+    std::unique_ptr<Picture> BatchRunner::createPicture(const vkcpp::Device *device,
+                                                        const vkcpp::CommandPool *command_pool,
+                                                        const BatchJob &job,
+                                                        const VkExtent3D &extent)
+    {
+        uint32_t island_count = std::max(job.island_count, 1u);
+        return std::make_unique<Picture>(device,
+                                         command_pool,
+                                         nullptr,
+                                         extent,
+                                         island_count,
+                                         job.population_size,
+                                         job.brush_count,
+                                         std::max(job.strip_count, 1u),
+                                         island_count);
+    }
+
+    void BatchRunner::run(const std::string &metrics_filename)
+    {
+        metrics_.open(metrics_filename, std::ios::out | std::ios::trunc);
+        next_job_ = 0;
+        uint32_t worker_count = std::min<uint32_t>(worker_count_, std::max<size_t>(jobs_.size(), 1));
+        std::vector<std::thread> workers;
+        for (uint32_t i = 0; i < worker_count; i++)
+        {
+            workers.emplace_back(&BatchRunner::run_worker, this, i);
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        metrics_.close();
+    }
+
+    void BatchRunner::run_worker(uint32_t worker)
+    {
+        // command pools are not thread safe : one per worker
+        auto command_pool = std::make_unique<vkcpp::CommandPool>(device_.get(), device_->get_graphics_queue(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+        std::unique_ptr<Picture> picture;
+        for (size_t idx = next_job_++; idx < jobs_.size(); idx = next_job_++)
+        {
+            const BatchJob &job = jobs_[idx];
+            auto start = std::chrono::high_resolution_clock::now();
+            double fitness = 0.0;
+            std::string error;
+            try
+            {
+                fitness = run_job(job, command_pool.get(), picture);
+            }
+            catch (const std::exception &e)
+            {
+                error = e.what();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(metrics_mutex_);
+            metrics_ << "{\"job\":" << idx << ",\"worker\":" << worker << ",\"target\":\"" << job.target << "\",\"output\":\"" << job.output
+                     << "\",\"runs\":" << job.run_count << ",\"seconds\":" << seconds;
+            if (error.empty())
+            {
+                metrics_ << ",\"fitness\":" << fitness << ",\"strokes\":" << picture->get_stroke_log().get_stroke_count() << "}\n";
+            }
+            else
+            {
+                metrics_ << ",\"error\":\"" << error << "\"}\n";
+                std::cerr << "batch job " << idx << " failed: " << error << "\n";
+            }
+            metrics_.flush();
+        }
+        picture.reset();
+        command_pool.reset();
+    }
+
+    double BatchRunner::run_job(const BatchJob &job, const vkcpp::CommandPool *command_pool, std::unique_ptr<Picture> &picture)
+    {
+        VKCPP_TRACE_SCOPE("BatchRunner::run_job");
+        VkExtent3D extent;
+        std::vector<char> target = loadTarget(job.target, extent);
+        const char *data = target.data();
+
+        // the previous picture is released after this one holds the shared pipeline state
+        auto next = createPicture(device_.get(), command_pool, job, extent);
+        picture = std::move(next);
+
+        for (uint32_t i = 0; i < job.run_count; i++)
+        {
+            picture->run(data);
+        }
+
+        picture->get_stroke_log().export_json(job.output + ".json", extent);
+        picture->save_snapshot(job.output + ".png");
+
+        double fitness = 0.0;
+        for (uint32_t i = 0; i < picture->get_strip_count(); i++)
+        {
+            fitness += picture->get_best_fitness(i);
+        }
+        return fitness / picture->get_strip_count();
+    }
+} // namespace painting
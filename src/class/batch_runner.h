@@ -0,0 +1,86 @@
+#ifndef CLASS_BATCH_RUNNER_H
+#define CLASS_BATCH_RUNNER_H
+
+#include "device/instance.h"
+#include "device/device.h"
+#include "render/command/command_pool.h"
+#include "picture.h"
+
+#include "stdafx.h"
+
+namespace painting
+{
+    /**
+     *  a manifest line : target output runs [population_size brush_count strip_count island_count]
+     */
+    struct BatchJob
+    {
+        std::string target;
+        // output prefix : .png canvas, .json stroke log
+        std::string output;
+        uint32_t run_count{1000};
+        uint32_t population_size{12};
+        uint32_t brush_count{3};
+        uint32_t strip_count{2};
+        uint32_t island_count{1};
+    }; // struct BatchJob
+
+    /**
+     *  Paints every job of a manifest in one process : one headless instance and device for all jobs,
+     *  a bounded set of workers (thread, command pool) each running one Picture at a time.
+     *  A worker keeps its last Picture until the next one is built, so pipelines and shader modules stay in the registry.
+     */
+    class BatchRunner
+    {
+    private:
+        std::unique_ptr<vkcpp::Instance> instance_;
+
+        std::unique_ptr<vkcpp::Device> device_;
+
+        std::vector<BatchJob> jobs_;
+
+        uint32_t worker_count_{1};
+
+        std::atomic<size_t> next_job_{0};
+
+        std::mutex metrics_mutex_;
+
+        std::ofstream metrics_;
+
+        void run_worker(uint32_t worker);
+
+        /**
+         *  @return mean best fitness of the strips
+         */
+        double run_job(const BatchJob &job, const vkcpp::CommandPool *command_pool, std::unique_ptr<Picture> &picture);
+
+    public:
+        BatchRunner(const std::string &manifest, uint32_t worker_count);
+
+        ~BatchRunner();
+
+        static std::vector<BatchJob> readManifest(const std::string &filename);
+
+        /**
+         *  @return false if the line has no target, output and run count
+         */
+        static bool parseJob(std::istream &stream, BatchJob &job);
+
+        /**
+         *  @brief target image -> r8g8b8a8 rows
+         */
+        static std::vector<char> loadTarget(const std::string &filename, VkExtent3D &extent);
+
+        static std::unique_ptr<Picture> createPicture(const vkcpp::Device *device,
+                                                      const vkcpp::CommandPool *command_pool,
+                                                      const BatchJob &job,
+                                                      const VkExtent3D &extent);
+
+        /**
+         *  @brief every job, metrics (one json object per job) -> metrics_filename
+         */
+        void run(const std::string &metrics_filename);
+    }; // class BatchRunner
+} // namespace painting
+
+#endif // #ifndef CLASS_BATCH_RUNNER_H
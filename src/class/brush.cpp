@@ -1,46 +1,119 @@
 #include "class/brush.h"
 
 #include "utility/utility.h"
+#include "device/device.h"
+#include "render/pipeline/graphics_pipeline.h"
+#include "render/pipeline/pipeline_registry.h"
+#include "render/image/image_atlas.h"
+#include "object/model.h"
 
 namespace painting
 {
     Brushes::Brushes(const vkcpp::Device *device,
                      const vkcpp::RenderStage *render_stage,
                      const vkcpp::CommandPool *command_pool,
-                     int brush_count)
+                     int capacity)
+        : capacity_(capacity)
     {
-        brushes_.push_back(std::make_unique<vkcpp::Object2D>(
+        brush_ = std::make_unique<vkcpp::Object2D>(
             device,
             render_stage,
             command_pool,
-            tex_[rand() % TEX_SIZE_]));
-        for (int i = 1; i < brush_count; i++)
+            tex_);
+        for (int i = 0; i < brush_->get_atlas_region_count(); i++)
         {
-            brushes_.push_back(std::make_unique<vkcpp::Object2D>(
-                brushes_[0].get()));
+            brush_->change_atlas_region(i);
+            region_commands_.push_back(brush_->get_indirect_command());
         }
+
+        uint32_t ubo_size = brush_->get_framebuffers_size();
+        ubo_ = std::make_unique<vkcpp::DynamicUniformBuffers<vkcpp::shader::attribute::TransformUBO>>(
+            device,
+            brush_->get_texture(),
+            ubo_size,
+            static_cast<uint32_t>(capacity_));
+
+        std::string vert_shader_file = "../shaders/vs_default.spv";
+        std::string frag_shader_file = "../shaders/fs_default.spv";
+        graphics_pipeline_ = device->get_pipeline_registry()->get_graphics_pipeline(
+            render_stage,
+            ubo_.get(),
+            vert_shader_file,
+            frag_shader_file,
+            0);
+
+        indirect_buffers_ = std::make_unique<vkcpp::IndirectBuffers>(device, ubo_size, static_cast<uint32_t>(capacity_));
+    }
+
+    Brushes::~Brushes()
+    {
+        indirect_buffers_.reset();
+        graphics_pipeline_.reset();
+        ubo_.reset();
+        brush_.reset();
+    }
+
+    std::vector<glm::vec2> Brushes::get_region_half_extents() const
+    {
+        std::vector<glm::vec2> half_extents;
+        if (auto atlas = dynamic_cast<const vkcpp::ImageAtlas *>(brush_->get_texture()))
+        {
+            for (auto &region : atlas->get_regions())
+            {
+                half_extents.push_back(glm::vec2(region.width, region.height) / 2.0f);
+            }
+        }
+        return half_extents;
     }
 
     void Brushes::draw_all(VkCommandBuffer command_buffer, int ubo_idx)
     {
-        int size = brushes_.size();
-        brushes_[0]->bind_graphics_pipeline(command_buffer);
-        for (int i = 0; i < size; i++)
+        draw_range(command_buffer, ubo_idx, 0, capacity_);
+    }
+
+    void Brushes::draw_range(VkCommandBuffer command_buffer, int ubo_idx, int first, int count)
+    {
+        graphics_pipeline_->bind_pipeline(command_buffer);
+        brush_->get_model()->bind(command_buffer);
+        int last = std::min(first + count, capacity_);
+        for (int i = std::max(first, 0); i < last; i++)
         {
-            brushes_[i]->draw_without_bind_graphics(command_buffer, ubo_idx);
+            uint32_t dynamic_offset = ubo_->get_dynamic_offset(i);
+            vkCmdBindDescriptorSets(
+                command_buffer,
+                graphics_pipeline_->get_pipeline_bind_point(),
+                graphics_pipeline_->get_pipeline_layout(),
+                0,
+                1,
+                &ubo_->get_sets()[ubo_idx],
+                1,
+                &dynamic_offset);
+            brush_->get_model()->draw_indirect(command_buffer,
+                                               indirect_buffers_->get_buffer(ubo_idx),
+                                               indirect_buffers_->get_offset(i));
         }
     }
 
+    void Brushes::set_draw_count(int count, int ubo_idx)
+    {
+        indirect_buffers_->set_draw_count(ubo_idx, static_cast<uint32_t>(std::clamp(count, 0, capacity_)));
+    }
+
     void Brushes::update(const BrushAttributeComponent &attribute, const vkcpp::Camera *camera, int idx, int ubo_idx)
     {
-        brushes_[idx]
-            ->init_transform(
-                attribute.translation,
-                attribute.scale,
-                glm::vec3(0.0f, 0.0f, attribute.rotation_z));
-        brushes_[idx]->init_color(attribute.color);
-        //  brushes_[idx]->change_texture(attribute.object_idx, ubo_idx);
-        brushes_[idx]->update_with_sub_camera(ubo_idx, camera);
+        vkcpp::TransformComponent transform{};
+        transform.translation = attribute.translation;
+        transform.scale = attribute.scale;
+        transform.rotation = glm::vec3(0.0f, 0.0f, attribute.rotation_z);
+
+        vkcpp::shader::attribute::TransformUBO ubo{};
+        ubo.model = transform.get_mat4();
+        ubo.color = attribute.color;
+        ubo.view = camera->get_view();
+        ubo.proj = camera->get_proj();
+
+        ubo_->update_uniform_buffer(ubo_idx, idx, ubo);
+        indirect_buffers_->set_command(ubo_idx, idx, region_commands_[attribute.object_idx % region_commands_.size()]);
     }
 }
 
@@ -50,27 +123,34 @@ namespace painting
                                      const glm::vec2 &extent,
                                      const glm::vec2 &scale_range,
                                      int size,
-                                     const Probablity &probablity)
+                                     const Probablity &probablity,
+                                     std::mt19937 &engine,
+                                     int max_size)
         : offset_(offset),
           extent_(extent),
-          probablity_(probablity)
+          scale_range_(scale_range),
+          probablity_(probablity),
+          max_size_(std::max(max_size, size))
     {
         for (int i = 0; i < size; i++)
         {
             attributes_.push_back(BrushAttributeComponent(scale_range));
-            set_rand_rotation(i);
-            set_rand_scale(i);
-            set_rand_translation(i);
-            set_rand_color(i);
-            set_rand_obj_idx(i);
+            set_rand_rotation(i, engine);
+            set_rand_scale(i, engine);
+            set_rand_translation(i, engine);
+            set_rand_obj_idx(i, engine);
+            // footprint of the final brush, scale, translation and rotation
+            set_seed_color(i, engine);
         }
     }
-    BrushAttributes::BrushAttributes(const BrushAttributes &a, const BrushAttributes &b)
+    BrushAttributes::BrushAttributes(const BrushAttributes &a, const BrushAttributes &b, std::mt19937 &engine)
     {
+        // length of a, b fills the strokes it has
         int size = a.attributes_.size();
+        int b_size = b.attributes_.size();
         for (int i = 0; i < size; i++)
         {
-            if (rand() % 2 == 0)
+            if (i >= b_size || engine() % 2 == 0)
             {
                 attributes_.push_back(a.attributes_[i]);
             }
@@ -81,7 +161,12 @@ namespace painting
         }
         offset_ = a.offset_;
         extent_ = a.extent_;
+        scale_range_ = a.scale_range_;
         probablity_ = a.probablity_;
+        steps_ = a.steps_;
+        max_size_ = a.max_size_;
+        error_map_ = a.error_map_;
+        target_colors_ = a.target_colors_;
         fitness_ = a.fitness_;
     }
 
@@ -89,102 +174,287 @@ namespace painting
     {
     }
 
-    std::unique_ptr<BrushAttributes> BrushAttributes::cross_over(const BrushAttributes &b)
+    std::unique_ptr<BrushAttributes> BrushAttributes::cross_over(const BrushAttributes &b, std::mt19937 &engine)
     {
-        return std::make_unique<BrushAttributes>(*this, b);
+        return std::make_unique<BrushAttributes>(*this, b, engine);
     }
-    void BrushAttributes::mutate(int idx)
+    void BrushAttributes::mutate(int idx, std::mt19937 &engine)
     {
-        if (rand() % 4 == 0)
+        if (engine() % 4 == 0)
         {
-            if (vkcpp::getProbablity() < probablity_.scale)
+            if (vkcpp::getProbablity(engine) < probablity_.scale)
             {
-                set_rand_scale(idx);
+                set_rand_scale(idx, engine);
             }
-            if (vkcpp::getProbablity() < probablity_.trans)
+            if (vkcpp::getProbablity(engine) < probablity_.trans)
             {
-                set_rand_translation(idx);
+                set_rand_translation(idx, engine);
             }
-            if (vkcpp::getProbablity() < probablity_.rotate)
+            if (vkcpp::getProbablity(engine) < probablity_.rotate)
             {
-                set_rand_rotation(idx);
+                set_rand_rotation(idx, engine);
             }
-            if (vkcpp::getProbablity() < probablity_.color)
+            if (vkcpp::getProbablity(engine) < probablity_.color)
             {
-                set_rand_color(idx);
+                set_rand_color(idx, engine);
             }
         }
         else
         {
-            set_rand_color(idx, true);
-            set_rand_rotation(idx);
-            set_rand_scale(idx, true);
-            set_rand_translation(idx, true);
+            set_rand_color(idx, engine, true);
+            set_rand_rotation(idx, engine);
+            set_rand_scale(idx, engine, true);
+            set_rand_translation(idx, engine, true);
+        }
+    }
+    static float normalRand(std::mt19937 &engine)
+    {
+        // box-muller
+        float u1 = std::max(vkcpp::getProbablity(engine), 1e-7f);
+        float u2 = vkcpp::getProbablity(engine);
+        return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.2831853f * u2);
+    }
+    static MutationStep clampSteps(const MutationStep &steps, const glm::vec2 &extent, const glm::vec2 &scale_range)
+    {
+        MutationStep ret;
+        ret.translation = std::clamp(steps.translation, 0.5f, std::max(0.5f, std::max(extent.x, extent.y) / 2.0f));
+        ret.scale = std::clamp(steps.scale, 1e-5f, std::max(1e-5f, scale_range.y - scale_range.x));
+        ret.rotation = std::clamp(steps.rotation, 0.01f, 3.15f);
+        ret.color = std::clamp(steps.color, 0.001f, 0.5f);
+        return ret;
+    }
+    void BrushAttributes::adapt_steps(std::mt19937 &engine)
+    {
+        // 4 steps : tau' = 1 / sqrt(2n), tau = 1 / sqrt(2 sqrt(n))
+        const float global_tau = 0.3536f;
+        const float local_tau = 0.4204f;
+        float global = global_tau * normalRand(engine);
+        steps_.translation *= std::exp(global + local_tau * normalRand(engine));
+        steps_.scale *= std::exp(global + local_tau * normalRand(engine));
+        steps_.rotation *= std::exp(global + local_tau * normalRand(engine));
+        steps_.color *= std::exp(global + local_tau * normalRand(engine));
+        steps_ = clampSteps(steps_, extent_, scale_range_);
+    }
+    void BrushAttributes::scale_steps(float factor)
+    {
+        steps_.translation *= factor;
+        steps_.scale *= factor;
+        steps_.rotation *= factor;
+        steps_.color *= factor;
+        steps_ = clampSteps(steps_, extent_, scale_range_);
+    }
+    void BrushAttributes::write(ByteWriter &writer) const
+    {
+        writer.put(fitness_);
+        writer.put(steps_);
+        writer.put<uint32_t>(attributes_.size());
+        for (auto &attribute : attributes_)
+        {
+            writeStroke(writer, attribute);
         }
     }
-    void BrushAttributes::set_rand_obj_idx(int idx)
+    void BrushAttributes::read(ByteReader &reader)
+    {
+        fitness_ = reader.get<double>();
+        steps_ = reader.get<MutationStep>();
+        uint32_t size = reader.get<uint32_t>();
+        attributes_.clear();
+        for (uint32_t i = 0; i < size; i++)
+        {
+            attributes_.push_back(readStroke(reader));
+        }
+    }
+    void BrushAttributes::writeStroke(ByteWriter &writer, const BrushAttributeComponent &stroke)
+    {
+        writer.put(stroke.scale_range_);
+        writer.put(stroke.scale);
+        writer.put(stroke.translation);
+        writer.put(stroke.rotation_z);
+        writer.put(stroke.color);
+        writer.put<int32_t>(stroke.object_idx);
+    }
+    BrushAttributeComponent BrushAttributes::readStroke(ByteReader &reader)
+    {
+        BrushAttributeComponent stroke(reader.get<glm::vec2>());
+        stroke.scale = reader.get<glm::vec3>();
+        stroke.translation = reader.get<glm::vec3>();
+        stroke.rotation_z = reader.get<float>();
+        stroke.color = reader.get<glm::vec4>();
+        stroke.object_idx = reader.get<int32_t>();
+        return stroke;
+    }
+    void BrushAttributes::get_genes(float *genes, size_t stride) const
+    {
+        glm::vec2 extent = glm::max(extent_, glm::vec2(1.0f));
+        float scale_extent = std::max(scale_range_.y - scale_range_.x, 1e-6f);
+        int size = attributes_.size();
+        for (int i = 0; i < size; i++)
+        {
+            const BrushAttributeComponent &attribute = attributes_[i];
+            float *gene = genes + i * GENE_SIZE_ * stride;
+            gene[0 * stride] = (attribute.translation.x - offset_.x) / extent.x;
+            gene[1 * stride] = (attribute.translation.y - offset_.y) / extent.y;
+            gene[2 * stride] = (attribute.scale.x - scale_range_.x) / scale_extent;
+            gene[3 * stride] = (attribute.scale.y - scale_range_.x) / scale_extent;
+            gene[4 * stride] = attribute.rotation_z / 6.3f;
+            gene[5 * stride] = attribute.color.r;
+            gene[6 * stride] = attribute.color.g;
+            gene[7 * stride] = attribute.color.b;
+            gene[8 * stride] = attribute.color.a;
+        }
+    }
+    void BrushAttributes::set_genes(const float *genes, size_t stride)
+    {
+        int size = attributes_.size();
+        for (int i = 0; i < size; i++)
+        {
+            BrushAttributeComponent &attribute = attributes_[i];
+            const float *gene = genes + i * GENE_SIZE_ * stride;
+            attribute.translation.x = offset_.x + std::clamp(gene[0 * stride], 0.0f, 1.0f) * extent_.x;
+            attribute.translation.y = offset_.y + std::clamp(gene[1 * stride], 0.0f, 1.0f) * extent_.y;
+            attribute.scale.x = scale_range_.x + std::clamp(gene[2 * stride], 0.0f, 1.0f) * (scale_range_.y - scale_range_.x);
+            attribute.scale.y = scale_range_.x + std::clamp(gene[3 * stride], 0.0f, 1.0f) * (scale_range_.y - scale_range_.x);
+            attribute.rotation_z = std::clamp(gene[4 * stride], 0.0f, 1.0f) * 6.3f;
+            attribute.color.r = std::clamp(gene[5 * stride], 0.0f, 1.0f);
+            attribute.color.g = std::clamp(gene[6 * stride], 0.0f, 1.0f);
+            attribute.color.b = std::clamp(gene[7 * stride], 0.0f, 1.0f);
+            attribute.color.a = std::clamp(gene[8 * stride], 0.0f, 1.0f);
+        }
+    }
+    void BrushAttributes::mutate_structure(std::mt19937 &engine)
+    {
+        int size = attributes_.size();
+        if (size < max_size_ && vkcpp::getProbablity(engine) < probablity_.insert)
+        {
+            insert_attribute(engine() % (size + 1), engine);
+        }
+        else if (size > 1 && vkcpp::getProbablity(engine) < probablity_.remove)
+        {
+            remove_attribute(engine() % size);
+        }
+        size = attributes_.size();
+        if (size > 1 && vkcpp::getProbablity(engine) < probablity_.reorder)
+        {
+            uint32_t from = engine() % size;
+            reorder_attribute(from, engine() % size);
+        }
+    }
+    void BrushAttributes::insert_attribute(int idx, std::mt19937 &engine)
+    {
+        if (static_cast<int>(attributes_.size()) >= max_size_ || idx < 0 || idx > static_cast<int>(attributes_.size()))
+        {
+            return;
+        }
+        attributes_.insert(attributes_.begin() + idx, BrushAttributeComponent(scale_range_));
+        set_rand_rotation(idx, engine);
+        set_rand_scale(idx, engine);
+        set_rand_translation(idx, engine);
+        set_rand_obj_idx(idx, engine);
+        set_seed_color(idx, engine);
+    }
+    void BrushAttributes::remove_attribute(int idx)
+    {
+        if (attributes_.size() <= 1 || idx < 0 || idx >= static_cast<int>(attributes_.size()))
+        {
+            return;
+        }
+        attributes_.erase(attributes_.begin() + idx);
+    }
+    void BrushAttributes::reorder_attribute(int from, int to)
+    {
+        int size = attributes_.size();
+        if (from < 0 || from >= size || to < 0 || to >= size || from == to)
+        {
+            return;
+        }
+        BrushAttributeComponent attribute = attributes_[from];
+        attributes_.erase(attributes_.begin() + from);
+        attributes_.insert(attributes_.begin() + to, attribute);
+    }
+    void BrushAttributes::set_rand_obj_idx(int idx, std::mt19937 &engine)
     {
         BrushAttributeComponent &attribute = attributes_[idx];
-        attribute.object_idx = rand() % Brushes::TEX_SIZE_;
+        attribute.object_idx = engine() % Brushes::TEX_SIZE_;
     }
-    void BrushAttributes::set_rand_scale(int idx, bool is_relative)
+    void BrushAttributes::set_rand_scale(int idx, std::mt19937 &engine, bool is_relative)
     {
         BrushAttributeComponent &attribute = attributes_[idx];
         if (is_relative)
         {
-            attribute.scale.x = std::clamp(vkcpp::getRandFloat(attribute.scale.x - 0.001f, attribute.scale.x + 0.001f), attribute.scale_range_.x, attribute.scale_range_.y);
-            attribute.scale.y = std::clamp(vkcpp::getRandFloat(attribute.scale.y - 0.001f, attribute.scale.y + 0.001f), attribute.scale_range_.x, attribute.scale_range_.y);
+            attribute.scale.x = std::clamp(vkcpp::getRandFloat(engine, attribute.scale.x - steps_.scale, attribute.scale.x + steps_.scale), attribute.scale_range_.x, attribute.scale_range_.y);
+            attribute.scale.y = std::clamp(vkcpp::getRandFloat(engine, attribute.scale.y - steps_.scale, attribute.scale.y + steps_.scale), attribute.scale_range_.x, attribute.scale_range_.y);
         }
         else
         {
-            attribute.scale.x = vkcpp::getRandFloat(attribute.scale_range_.x, attribute.scale_range_.y);
-            attribute.scale.y = vkcpp::getRandFloat(attribute.scale_range_.x, attribute.scale_range_.y);
+            attribute.scale.x = vkcpp::getRandFloat(engine, attribute.scale_range_.x, attribute.scale_range_.y);
+            attribute.scale.y = vkcpp::getRandFloat(engine, attribute.scale_range_.x, attribute.scale_range_.y);
         }
     }
-    void BrushAttributes::set_rand_translation(int idx, bool is_relative)
+    void BrushAttributes::set_rand_translation(int idx, std::mt19937 &engine, bool is_relative)
     {
         BrushAttributeComponent &attribute = attributes_[idx];
         if (is_relative)
         {
-            attribute.translation.x = std::clamp(vkcpp::getRandFloat(attribute.translation.x - 15.0f, attribute.translation.x + 15.0f), offset_.x, offset_.x + extent_.x);
-            attribute.translation.y = std::clamp(vkcpp::getRandFloat(attribute.translation.y - 15.0f, attribute.translation.y + 15.0f), offset_.y, offset_.y + extent_.y);
-            attribute.translation.z = -std::clamp(vkcpp::getRandFloat(attribute.translation.z - 5.0f, attribute.translation.z + 5.0f), 1.0f, 50.0f);
+            attribute.translation.x = std::clamp(vkcpp::getRandFloat(engine, attribute.translation.x - steps_.translation, attribute.translation.x + steps_.translation), offset_.x, offset_.x + extent_.x);
+            attribute.translation.y = std::clamp(vkcpp::getRandFloat(engine, attribute.translation.y - steps_.translation, attribute.translation.y + steps_.translation), offset_.y, offset_.y + extent_.y);
+            attribute.translation.z = -std::clamp(vkcpp::getRandFloat(engine, attribute.translation.z - 5.0f, attribute.translation.z + 5.0f), 1.0f, 50.0f);
+        }
+        else if (error_map_ != nullptr)
+        {
+            glm::vec2 position = error_map_->sample(engine);
+            attribute.translation.x = position.x;
+            attribute.translation.y = position.y;
+            attribute.translation.z = vkcpp::getRandFloat(engine, 1.0f, 50.0f);
         }
         else
         {
-            attribute.translation.x = vkcpp::getRandFloat(offset_.x, offset_.x + extent_.x);
-            attribute.translation.y = vkcpp::getRandFloat(offset_.y, offset_.y + extent_.y);
-            attribute.translation.z = vkcpp::getRandFloat(1.0f, 50.0f);
+            attribute.translation.x = vkcpp::getRandFloat(engine, offset_.x, offset_.x + extent_.x);
+            attribute.translation.y = vkcpp::getRandFloat(engine, offset_.y, offset_.y + extent_.y);
+            attribute.translation.z = vkcpp::getRandFloat(engine, 1.0f, 50.0f);
         }
     }
-    void BrushAttributes::set_rand_rotation(int idx, bool is_relative)
+    void BrushAttributes::set_rand_rotation(int idx, std::mt19937 &engine, bool is_relative)
     {
         BrushAttributeComponent &attribute = attributes_[idx];
         if (is_relative)
         {
-            attribute.rotation_z = std::clamp(vkcpp::getRandFloat(attribute.rotation_z - 0.3f, attribute.rotation_z + 0.3f), 0.0f, 6.3f);
+            attribute.rotation_z = std::clamp(vkcpp::getRandFloat(engine, attribute.rotation_z - steps_.rotation, attribute.rotation_z + steps_.rotation), 0.0f, 6.3f);
         }
         else
         {
-            attribute.rotation_z = vkcpp::getRandFloat(0.0f, 6.3f);
+            attribute.rotation_z = vkcpp::getRandFloat(engine, 0.0f, 6.3f);
         }
     }
-    void BrushAttributes::set_rand_color(int idx, bool is_relative)
+    void BrushAttributes::set_seed_color(int idx, std::mt19937 &engine)
+    {
+        if (target_colors_ == nullptr)
+        {
+            set_rand_color(idx, engine);
+            return;
+        }
+        BrushAttributeComponent &attribute = attributes_[idx];
+        glm::vec3 color = target_colors_->get_footprint_color(attribute.translation, attribute.scale, attribute.rotation_z, attribute.object_idx);
+        attribute.color.r = color.r;
+        attribute.color.g = color.g;
+        attribute.color.b = color.b;
+        attribute.color.a = vkcpp::getRandFloat(engine, 0.0f, 1.0f);
+    }
+    void BrushAttributes::set_rand_color(int idx, std::mt19937 &engine, bool is_relative)
     {
         BrushAttributeComponent &attribute = attributes_[idx];
         if (is_relative)
         {
-            attribute.color.r = std::clamp(vkcpp::getRandFloat(attribute.color.r - 0.02f, attribute.color.r + 0.02f), 0.0f, 1.0f);
-            attribute.color.g = std::clamp(vkcpp::getRandFloat(attribute.color.g - 0.02f, attribute.color.g + 0.02f), 0.0f, 1.0f);
-            attribute.color.b = std::clamp(vkcpp::getRandFloat(attribute.color.b - 0.02f, attribute.color.b + 0.02f), 0.0f, 1.0f);
-            attribute.color.a = std::clamp(vkcpp::getRandFloat(attribute.color.a, attribute.color.a + 0.001f), 0.0f, 1.0f);
+            attribute.color.r = std::clamp(vkcpp::getRandFloat(engine, attribute.color.r - steps_.color, attribute.color.r + steps_.color), 0.0f, 1.0f);
+            attribute.color.g = std::clamp(vkcpp::getRandFloat(engine, attribute.color.g - steps_.color, attribute.color.g + steps_.color), 0.0f, 1.0f);
+            attribute.color.b = std::clamp(vkcpp::getRandFloat(engine, attribute.color.b - steps_.color, attribute.color.b + steps_.color), 0.0f, 1.0f);
+            attribute.color.a = std::clamp(vkcpp::getRandFloat(engine, attribute.color.a, attribute.color.a + 0.001f), 0.0f, 1.0f);
         }
         else
         {
-            attribute.color.r = vkcpp::getRandFloat(0.0f, 1.0f);
-            attribute.color.g = vkcpp::getRandFloat(0.0f, 1.0f);
-            attribute.color.b = vkcpp::getRandFloat(0.0f, 1.0f);
-            attribute.color.a = vkcpp::getRandFloat(0.0f, 1.0f);
+            attribute.color.r = vkcpp::getRandFloat(engine, 0.0f, 1.0f);
+            attribute.color.g = vkcpp::getRandFloat(engine, 0.0f, 1.0f);
+            attribute.color.b = vkcpp::getRandFloat(engine, 0.0f, 1.0f);
+            attribute.color.a = vkcpp::getRandFloat(engine, 0.0f, 1.0f);
         }
     }
 }
\ No newline at end of file
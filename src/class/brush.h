@@ -3,9 +3,15 @@
 
 #include "object/object2d.h"
 #include "object/camera/sub_camera.h"
+#include "render/buffer/indirect_buffers.h"
+#include "render/buffer/dynamic_uniform_buffers.hpp"
+#include "error_map.h"
+#include "target_colors.h"
 
 #include "stdafx.h"
 
+#include <random>
+
 namespace painting
 {
     struct BrushAttributeComponent
@@ -23,31 +29,75 @@ namespace painting
         }
     }; // struct BrushAttributeComponent
 
+    /**
+     *  relative mutation ranges (+-) of a genome
+     */
+    struct MutationStep
+    {
+        float translation{15.0f};
+        float scale{0.001f};
+        float rotation{0.3f};
+        float color{0.02f};
+    }; // struct MutationStep
+
     class Brushes
     {
     public:
         static const int TEX_SIZE_ = 4;
 
     private:
-        const char *tex_[4] = {
+        // packed into one atlas, BrushAttributeComponent::object_idx selects the region
+        std::vector<const char *> tex_ = {
             "../textures/brushes/1.png",
             "../textures/brushes/4.png",
             "../textures/brushes/6.png",
             "../textures/brushes/9.png"};
-        //   brushes_[0].push_back(std::make_unique<Brush>(device_, render_stage_, command_pool_, 0));
-        std::vector<std::unique_ptr<vkcpp::Object2D>> brushes_;
+        // atlas texture and quads, strokes are slots of one dynamic ubo (no object per stroke)
+        std::unique_ptr<vkcpp::Object2D> brush_;
+
+        std::unique_ptr<vkcpp::DynamicUniformBuffers<vkcpp::shader::attribute::TransformUBO>> ubo_;
+
+        std::shared_ptr<vkcpp::GraphicsPipeline> graphics_pipeline_;
+
+        // draw parameters per stroke and ubo : count and atlas region change without re-recording
+        std::unique_ptr<vkcpp::IndirectBuffers> indirect_buffers_;
+
+        // draw parameters of each atlas region
+        std::vector<VkDrawIndexedIndirectCommand> region_commands_;
+
+        int capacity_{0};
 
     public:
+        /**
+         *  @param capacity max strokes drawn with one command buffer
+         */
         Brushes(const vkcpp::Device *device,
                 const vkcpp::RenderStage *render_stage,
                 const vkcpp::CommandPool *command_pool,
-                int brush_count);
+                int capacity);
+        ~Brushes();
         const int get_brushes_size() const
         {
-            return brushes_.size();
+            return capacity_;
         }
+        const std::vector<const char *> &get_texture_files() const
+        {
+            return tex_;
+        }
+        /**
+         *  @return half size in pixels of each atlas region (scale 1)
+         */
+        std::vector<glm::vec2> get_region_half_extents() const;
         void draw_all(VkCommandBuffer command_buffer, int ubo_idx);
+        /**
+         *  @brief only brushes [first, first + count) (clamped to the capacity)
+         */
+        void draw_range(VkCommandBuffer command_buffer, int ubo_idx, int first, int count);
         void update(const BrushAttributeComponent &attribute, const vkcpp::Camera *camera, int idx, int ubo_idx);
+        /**
+         *  @brief only brushes [0, count) are drawn with ubo_idx
+         */
+        void set_draw_count(int count, int ubo_idx);
     }; // class Brushes
 
     class BrushAttributes
@@ -59,6 +109,10 @@ namespace painting
             float trans{0.1f};
             float rotate{0.1f};
             float color{0.1f};
+            // structure
+            float insert{0.1f};
+            float remove{0.05f};
+            float reorder{0.05f};
             Probablity() = default;
             Probablity(float s, float t, float r, float c)
                 : scale(s), trans(t), rotate(r), color(c)
@@ -74,17 +128,34 @@ namespace painting
         // for generate range (translation)
         glm::vec2 offset_{};
         glm::vec2 extent_{};
+        glm::vec2 scale_range_{};
         double fitness_{0.0};
         Probablity probablity_;
+        MutationStep steps_{};
+        // stroke cap
+        int max_size_{0};
+        // new positions are weighted by residual (nullptr : uniform)
+        const ErrorMap *error_map_{nullptr};
+        // new strokes take the target color under them (nullptr : random)
+        const TargetColors *target_colors_{nullptr};
 
     public:
+        // continuous genes per stroke : translation xy, scale xy, rotation, rgba
+        static const int GENE_SIZE_ = 9;
+
+        /**
+         *  @param engine of the owning population (every random draw of a genome uses the caller's engine)
+         *  @param max_size stroke cap (0 : size)
+         */
         BrushAttributes(const glm::vec2 &offset,
                         const glm::vec2 &extent,
                         const glm::vec2 &scale_range,
                         int size,
-                        const Probablity &p);
+                        const Probablity &p,
+                        std::mt19937 &engine,
+                        int max_size = 0);
 
-        BrushAttributes(const BrushAttributes &a, const BrushAttributes &b);
+        BrushAttributes(const BrushAttributes &a, const BrushAttributes &b, std::mt19937 &engine);
 
         ~BrushAttributes();
 
@@ -92,6 +163,14 @@ namespace painting
         {
             return attributes_[idx];
         }
+        BrushAttributeComponent &get_mutable_attribute(int idx)
+        {
+            return attributes_[idx];
+        }
+        const int get_size() const
+        {
+            return attributes_.size();
+        }
 
         bool operator<(BrushAttributes &a)
         {
@@ -105,15 +184,69 @@ namespace painting
         {
             return fitness_;
         }
-        std::unique_ptr<BrushAttributes> cross_over(const BrushAttributes &a);
+        std::unique_ptr<BrushAttributes> cross_over(const BrushAttributes &a, std::mt19937 &engine);
+
+        void mutate(int idx, std::mt19937 &engine);
+
+        const MutationStep &get_steps() const { return steps_; }
+
+        /**
+         *  @brief log-normal self-adaptation : steps *= exp(tau' * N + tau * N_i), clamped
+         */
+        void adapt_steps(std::mt19937 &engine);
+
+        /**
+         *  @brief every step *= factor, clamped (1/5th success rule)
+         */
+        void scale_steps(float factor);
+
+        /**
+         *  @brief genes normalized to [0, 1] by the ranges of this genome, gene g of stroke i is genes[(i * GENE_SIZE_ + g) * stride]
+         */
+        void get_genes(float *genes, size_t stride = 1) const;
+
+        /**
+         *  @brief fitness, mutation steps and strokes (the ranges belong to the population)
+         */
+        void write(ByteWriter &writer) const;
+
+        void read(ByteReader &reader);
+
+        /**
+         *  @brief one stroke, shared by the genomes and the stroke log
+         */
+        static void writeStroke(ByteWriter &writer, const BrushAttributeComponent &stroke);
+
+        static BrushAttributeComponent readStroke(ByteReader &reader);
+
+        /**
+         *  @brief inverse of get_genes, clamped to the ranges
+         */
+        void set_genes(const float *genes, size_t stride = 1);
+
+        /**
+         *  @brief insert, remove or reorder strokes (painting order is stroke order)
+         */
+        void mutate_structure(std::mt19937 &engine);
+
+        void insert_attribute(int idx, std::mt19937 &engine);
+        void remove_attribute(int idx);
+        void reorder_attribute(int from, int to);
+
+        void set_error_map(const ErrorMap *error_map) { error_map_ = error_map; }
+
+        void set_target_colors(const TargetColors *target_colors) { target_colors_ = target_colors; }
 
-        void mutate(int idx);
+        /**
+         *  @brief initial color of a stroke : mean target color under the footprint
+         */
+        void set_seed_color(int idx, std::mt19937 &engine);
 
-        void set_rand_obj_idx(int idx);
-        void set_rand_scale(int idx, bool is_relative = false);
-        void set_rand_translation(int idx, bool is_relative = false);
-        void set_rand_rotation(int idx, bool is_relative = false);
-        void set_rand_color(int idx, bool is_relative = false);
+        void set_rand_obj_idx(int idx, std::mt19937 &engine);
+        void set_rand_scale(int idx, std::mt19937 &engine, bool is_relative = false);
+        void set_rand_translation(int idx, std::mt19937 &engine, bool is_relative = false);
+        void set_rand_rotation(int idx, std::mt19937 &engine, bool is_relative = false);
+        void set_rand_color(int idx, std::mt19937 &engine, bool is_relative = false);
     }; // class BrushAttributes
 }
 #endif
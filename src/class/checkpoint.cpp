@@ -0,0 +1,87 @@
+#include "checkpoint.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace painting
+{
+    Checkpoint::~Checkpoint()
+    {
+        wait();
+    }
+
+    void Checkpoint::write_async(const std::string &filename, std::vector<char> bytes)
+    {
+        wait();
+        thread_ = std::thread(&Checkpoint::writeFile, filename, std::move(bytes));
+    }
+
+    void Checkpoint::wait()
+    {
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    /**
+     *  @brief rename over an existing file (std::rename fails on windows if the target exists)
+     */
+    static bool replaceFile(const std::string &from, const std::string &to)
+    {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    void Checkpoint::writeFile(const std::string &filename, const std::vector<char> &bytes)
+    {
+        // a crash while writing keeps the previous checkpoint
+        std::string tmp_filename = filename + ".tmp";
+        std::ofstream file(tmp_filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "failed to open checkpoint file: " << tmp_filename << "\n";
+            return;
+        }
+        file.write(bytes.data(), bytes.size());
+        file.close();
+        if (!file || !replaceFile(tmp_filename, filename))
+        {
+            std::cerr << "failed to write checkpoint file: " << filename << "\n";
+        }
+    }
+
+    bool Checkpoint::readFile(const std::string &filename, std::vector<char> &bytes)
+    {
+        std::ifstream file(filename, std::ios::ate | std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        size_t file_size = static_cast<size_t>(file.tellg());
+        bytes.resize(file_size);
+        file.seekg(0);
+        file.read(bytes.data(), file_size);
+        return static_cast<bool>(file);
+    }
+
+    uint64_t Checkpoint::hashBytes(const char *data, size_t size)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+} // namespace painting
@@ -0,0 +1,107 @@
+#ifndef CLASS_CHECKPOINT_H
+#define CLASS_CHECKPOINT_H
+
+#include "vkcpp/stdafx.h"
+
+#include <type_traits>
+
+namespace painting
+{
+    /**
+     *  append only byte buffer of a checkpoint (host byte order)
+     */
+    class ByteWriter
+    {
+    private:
+        std::vector<char> bytes_;
+
+    public:
+        template <typename T>
+        void put(const T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+            const char *src = reinterpret_cast<const char *>(&value);
+            bytes_.insert(bytes_.end(), src, src + sizeof(T));
+        }
+
+        void put_bytes(const char *data, size_t size)
+        {
+            bytes_.insert(bytes_.end(), data, data + size);
+        }
+
+        std::vector<char> &get_mutable_bytes() { return bytes_; }
+    }; // class ByteWriter
+
+    class ByteReader
+    {
+    private:
+        const std::vector<char> &bytes_;
+
+        size_t offset_{0};
+
+    public:
+        explicit ByteReader(const std::vector<char> &bytes) : bytes_(bytes) {}
+
+        template <typename T>
+        T get()
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+            T value;
+            get_bytes(reinterpret_cast<char *>(&value), sizeof(T));
+            return value;
+        }
+
+        void get_bytes(char *dst, size_t size)
+        {
+            if (offset_ + size > bytes_.size())
+            {
+                throw std::runtime_error("failed to read checkpoint! truncated");
+            }
+            memcpy(dst, bytes_.data() + offset_, size);
+            offset_ += size;
+        }
+    }; // class ByteReader
+
+    /**
+     *  Writes checkpoints on a background thread (temporary file, then rename),
+     *  a new write waits for the previous one.
+     *
+     *  Layout (version 5) : magic, version, config (extent, strips, islands, population and stroke sizes, target hash),
+     *  strip index, run count, accepted count, canvas r8g8b8a8 pixels, then every population
+     *  (component, best fitness, engine state, error map residuals, genomes : fitness, mutation steps, strokes),
+     *  the migrant of every population (flag, genome), then the stroke log (records : run, strip, strip area, fitness, strokes).
+     */
+    class Checkpoint
+    {
+    private:
+        std::thread thread_;
+
+        static void writeFile(const std::string &filename, const std::vector<char> &bytes);
+
+    public:
+        static const uint32_t MAGIC_ = 0x43504b56; // "VKPC"
+        static const uint32_t VERSION_ = 5;
+
+        Checkpoint() = default;
+
+        Checkpoint(const Checkpoint &) = delete;
+
+        ~Checkpoint();
+
+        void write_async(const std::string &filename, std::vector<char> bytes);
+
+        void wait();
+
+        /**
+         *  @return false if the file does not exist
+         */
+        static bool readFile(const std::string &filename, std::vector<char> &bytes);
+
+        /**
+         *  @brief fnv-1a, identifies the target of a checkpoint
+         */
+        static uint64_t hashBytes(const char *data, size_t size);
+    }; // class Checkpoint
+} // namespace painting
+
+#endif // #ifndef CLASS_CHECKPOINT_H
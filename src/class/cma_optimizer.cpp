@@ -0,0 +1,180 @@
+#include "cma_optimizer.h"
+
+#include <cmath>
+#include <numeric>
+
+namespace painting
+{
+    CmaState::CmaState(const BrushAttributes &parent, uint32_t lambda, float sigma)
+        : n(parent.get_size() * BrushAttributes::GENE_SIZE_), lambda(lambda), sigma(sigma)
+    {
+        base = std::make_unique<BrushAttributes>(parent);
+        mean.resize(n);
+        parent.get_genes(mean.data());
+        diagonal.assign(n, 1.0f);
+        path_sigma.assign(n, 0.0f);
+        path_c.assign(n, 0.0f);
+        z.resize(n * lambda);
+        x.resize(n * lambda);
+    }
+
+    SepCmaOptimizer::SepCmaOptimizer(float initial_sigma)
+        : initial_sigma_(initial_sigma)
+    {
+    }
+
+    CmaState &SepCmaOptimizer::get_state(Population &population) const
+    {
+        std::unique_ptr<OptimizerState> &state = population.get_mutable_optimizer_state();
+        CmaState *cma = dynamic_cast<CmaState *>(state.get());
+        const BrushAttributes &parent = *population.top();
+        uint32_t lambda = population.get_size();
+        if (cma == nullptr || cma->n != parent.get_size() * BrushAttributes::GENE_SIZE_ || cma->lambda != lambda)
+        {
+            state = std::make_unique<CmaState>(parent, lambda, initial_sigma_);
+            cma = static_cast<CmaState *>(state.get());
+        }
+        return *cma;
+    }
+
+    void SepCmaOptimizer::next_stage(Population &population) const
+    {
+        CmaState &state = get_state(population);
+        population.get_mutable_component().stage_count++;
+        // every candidate is a sample, compared with the previous best
+        population.begin_children(0);
+        uint32_t n = state.n;
+        uint32_t lambda = state.lambda;
+
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        for (float &value : state.z)
+        {
+            value = normal(population.get_mutable_engine());
+        }
+        // x = m + sigma * sqrt(C) * z
+        for (uint32_t j = 0; j < n; j++)
+        {
+            float m = state.mean[j];
+            float scale = state.sigma * std::sqrt(state.diagonal[j]);
+            const float *z = &state.z[j * lambda];
+            float *x = &state.x[j * lambda];
+            for (uint32_t k = 0; k < lambda; k++)
+            {
+                x[k] = m + scale * z[k];
+            }
+        }
+        for (uint32_t k = 0; k < lambda; k++)
+        {
+            auto child = std::make_unique<BrushAttributes>(*state.base);
+            child->set_genes(&state.x[k], lambda);
+            population.set(k, std::move(child));
+        }
+    }
+
+    void SepCmaOptimizer::end_stage(Population &population) const
+    {
+        CmaState &state = get_state(population);
+        uint32_t n = state.n;
+        uint32_t lambda = state.lambda;
+
+        // evaluated genes (clamped, or replaced by migration) : y = (x - m) / sigma, z = y / sqrt(C)
+        std::vector<float> genes(n);
+        std::vector<uint32_t> ranks;
+        for (uint32_t k = 0; k < lambda; k++)
+        {
+            BrushAttributes *genome = population.get(k);
+            if (genome->get_size() * BrushAttributes::GENE_SIZE_ != static_cast<int>(n))
+            {
+                continue;
+            }
+            genome->get_genes(genes.data());
+            for (uint32_t j = 0; j < n; j++)
+            {
+                state.x[j * lambda + k] = genes[j];
+            }
+            ranks.push_back(k);
+        }
+        std::sort(ranks.begin(), ranks.end(), [&population](uint32_t a, uint32_t b)
+                  { return population.get(a)->get_fitness() > population.get(b)->get_fitness(); });
+
+        uint32_t mu = ranks.size() / 2;
+        if (mu == 0 || n == 0)
+        {
+            population.sort();
+            return;
+        }
+        std::vector<float> weights(mu);
+        for (uint32_t i = 0; i < mu; i++)
+        {
+            weights[i] = std::log(mu + 0.5f) - std::log(i + 1.0f);
+        }
+        float weight_sum = std::accumulate(weights.begin(), weights.end(), 0.0f);
+        float square_sum = 0.0f;
+        for (float &w : weights)
+        {
+            w /= weight_sum;
+            square_sum += w * w;
+        }
+        float mu_eff = 1.0f / square_sum;
+        float dim = static_cast<float>(n);
+
+        float c_sigma = (mu_eff + 2.0f) / (dim + mu_eff + 5.0f);
+        float d_sigma = 1.0f + 2.0f * std::max(0.0f, std::sqrt((mu_eff - 1.0f) / (dim + 1.0f)) - 1.0f) + c_sigma;
+        float c_c = (4.0f + mu_eff / dim) / (dim + 4.0f + 2.0f * mu_eff / dim);
+        // separable : learning rates * (n + 2) / 3
+        float c_1 = std::min(1.0f, (dim + 2.0f) / 3.0f * 2.0f / ((dim + 1.3f) * (dim + 1.3f) + mu_eff));
+        float c_mu = std::min(1.0f - c_1, (dim + 2.0f) / 3.0f * 2.0f * (mu_eff - 2.0f + 1.0f / mu_eff) / ((dim + 2.0f) * (dim + 2.0f) + mu_eff));
+        float chi_n = std::sqrt(dim) * (1.0f - 1.0f / (4.0f * dim) + 1.0f / (21.0f * dim * dim));
+
+        float sigma = state.sigma;
+        float norm_sigma = 0.0f;
+        std::vector<float> y_w(n);
+        for (uint32_t j = 0; j < n; j++)
+        {
+            float m = state.mean[j];
+            float inv_sqrt_c = 1.0f / std::sqrt(state.diagonal[j]);
+            const float *x = &state.x[j * lambda];
+            float y = 0.0f;
+            for (uint32_t i = 0; i < mu; i++)
+            {
+                y += weights[i] * (x[ranks[i]] - m);
+            }
+            y /= sigma;
+            y_w[j] = y;
+            state.mean[j] = m + sigma * y;
+
+            float &p_sigma = state.path_sigma[j];
+            p_sigma = (1.0f - c_sigma) * p_sigma + std::sqrt(c_sigma * (2.0f - c_sigma) * mu_eff) * y * inv_sqrt_c;
+            norm_sigma += p_sigma * p_sigma;
+        }
+        norm_sigma = std::sqrt(norm_sigma);
+        state.generation++;
+        float h_sigma = (norm_sigma / std::sqrt(1.0f - std::pow(1.0f - c_sigma, 2.0f * state.generation)) < (1.4f + 2.0f / (dim + 1.0f)) * chi_n) ? 1.0f : 0.0f;
+
+        for (uint32_t j = 0; j < n; j++)
+        {
+            float &p_c = state.path_c[j];
+            p_c = (1.0f - c_c) * p_c + h_sigma * std::sqrt(c_c * (2.0f - c_c) * mu_eff) * y_w[j];
+
+            float m = state.mean[j] - sigma * y_w[j];
+            const float *x = &state.x[j * lambda];
+            float rank_mu = 0.0f;
+            for (uint32_t i = 0; i < mu; i++)
+            {
+                float y = (x[ranks[i]] - m) / sigma;
+                rank_mu += weights[i] * y * y;
+            }
+            float &c = state.diagonal[j];
+            c = (1.0f - c_1 - c_mu) * c + c_1 * (p_c * p_c + (1.0f - h_sigma) * c_c * (2.0f - c_c) * c) + c_mu * rank_mu;
+            c = std::max(c, 1e-12f);
+        }
+        state.sigma = std::clamp(sigma * std::exp(c_sigma / d_sigma * (norm_sigma / chi_n - 1.0f)), 1e-6f, 1.0f);
+
+        population.sort();
+    }
+
+    bool SepCmaOptimizer::accept(Population &population, double fitness) const
+    {
+        return fitness > population.get_best();
+    }
+} // namespace painting
@@ -0,0 +1,62 @@
+#ifndef CLASS_CMA_OPTIMIZER_H
+#define CLASS_CMA_OPTIMIZER_H
+
+#include "optimizer.h"
+
+#include <random>
+
+namespace painting
+{
+    /**
+     *  sep-CMA-ES state of a population (diagonal covariance, O(n) per sample).
+     *  Matrices are gene major : [gene * lambda + sample], loops over samples are contiguous.
+     */
+    class CmaState : public OptimizerState
+    {
+    public:
+        uint32_t n{0};
+        uint32_t lambda{0};
+        uint32_t generation{0};
+
+        // strokes layout of the samples (object_idx, ranges)
+        std::unique_ptr<BrushAttributes> base;
+
+        std::vector<float> mean;
+        std::vector<float> diagonal;
+        std::vector<float> path_sigma;
+        std::vector<float> path_c;
+        float sigma{0.2f};
+
+        std::vector<float> z;
+        std::vector<float> x;
+
+        CmaState(const BrushAttributes &parent, uint32_t lambda, float sigma);
+    }; // class CmaState
+
+    /**
+     *  separable CMA-ES (Ros and Hansen, 2008) over the normalized continuous genes of the best genome,
+     *  every candidate of the population is a sample. The stroke structure is fixed while the state lives,
+     *  the state restarts when the parent length changes.
+     */
+    class SepCmaOptimizer : public Optimizer
+    {
+    private:
+        float initial_sigma_{0.2f};
+
+        CmaState &get_state(Population &population) const;
+
+    public:
+        explicit SepCmaOptimizer(float initial_sigma = 0.2f);
+
+        void next_stage(Population &population) const override;
+
+        /**
+         *  @brief ranks the evaluated candidates, updates mean, step size and covariance, then sorts
+         */
+        void end_stage(Population &population) const override;
+
+        bool accept(Population &population, double fitness) const override;
+    }; // class SepCmaOptimizer
+} // namespace painting
+
+#endif // #ifndef CLASS_CMA_OPTIMIZER_H
@@ -0,0 +1,207 @@
+#include "coordinator.h"
+
+#include "utility/image_encoder.h"
+#include "utility/trace.h"
+
+namespace painting
+{
+    Coordinator::Coordinator(const char *data, const VkExtent3D &extent, const BatchJob &job, const std::vector<std::string> &addresses)
+        : data_(data), extent_(extent)
+    {
+        if (addresses.empty())
+        {
+            throw std::runtime_error("coordinator needs at least one worker!");
+        }
+        uint32_t strip_count = std::max(job.strip_count, 1u);
+        size_t image_size = static_cast<size_t>(extent_.width) * extent_.height * 4;
+        canvas_.assign(image_size, static_cast<char>(255));
+
+        ByteWriter hello;
+        hello.put(Connection::MAGIC_);
+        hello.put(Connection::VERSION_);
+        hello.put(extent_.width);
+        hello.put(extent_.height);
+        hello.put(job.population_size);
+        hello.put(job.brush_count);
+        hello.put(strip_count);
+        hello.put_bytes(data_, image_size);
+        hello.put_bytes(canvas_.data(), image_size);
+
+        for (auto &address : addresses)
+        {
+            workers_.push_back(Connection::connectTo(address));
+        }
+        broadcast(MessageType::HELLO, hello.get_mutable_bytes());
+
+        // every worker loads the same brushes : the first one seeds the target colors
+        std::vector<glm::vec2> half_extents;
+        std::vector<char> payload;
+        for (auto &worker : workers_)
+        {
+            if (worker->receive(payload) != MessageType::READY)
+            {
+                throw std::runtime_error("expected READY from the worker!");
+            }
+            if (half_extents.empty())
+            {
+                ByteReader reader(payload);
+                half_extents.resize(reader.get<uint32_t>());
+                for (auto &half_extent : half_extents)
+                {
+                    half_extent = reader.get<glm::vec2>();
+                }
+            }
+        }
+
+        strips_ = Picture::createStrips(extent_, job.population_size, job.brush_count, strip_count, 1, std::random_device{}());
+        target_colors_ = std::make_unique<TargetColors>(data_, extent_.width, extent_.height, half_extents);
+        for (auto &strip : strips_)
+        {
+            strip->set_target_colors(target_colors_.get());
+        }
+        Picture::updateErrorMaps(strips_, data_, canvas_.data(), extent_.width, 0, extent_.height);
+        optimizer_ = std::make_unique<GeneticOptimizer>();
+    }
+
+    Coordinator::~Coordinator()
+    {
+        for (auto &worker : workers_)
+        {
+            try
+            {
+                worker->send(MessageType::BYE, {});
+            }
+            catch (const std::exception &)
+            {
+                // the worker is already gone
+            }
+        }
+    }
+
+    void Coordinator::broadcast(MessageType type, const std::vector<char> &payload)
+    {
+        for (auto &worker : workers_)
+        {
+            worker->send(type, payload);
+        }
+    }
+
+    void Coordinator::evaluate(Population &population)
+    {
+        VKCPP_TRACE_SCOPE("Coordinator::evaluate");
+        uint32_t size = static_cast<uint32_t>(population.get_size());
+        uint32_t worker_count = static_cast<uint32_t>(workers_.size());
+        std::vector<std::thread> threads;
+        std::vector<std::string> errors(worker_count);
+        for (uint32_t w = 0; w < worker_count; w++)
+        {
+            // contiguous batch [begin, end) of worker w
+            uint32_t begin = size * w / worker_count;
+            uint32_t end = size * (w + 1) / worker_count;
+            if (begin == end)
+            {
+                continue;
+            }
+            threads.emplace_back([this, &population, &errors, w, begin, end]()
+                                 {
+                                     try
+                                     {
+                                         ByteWriter writer;
+                                         writer.put(strip_idx_);
+                                         writer.put(end - begin);
+                                         for (uint32_t i = begin; i < end; i++)
+                                         {
+                                             population.get(i)->write(writer);
+                                         }
+                                         workers_[w]->send(MessageType::EVALUATE, writer.get_mutable_bytes());
+
+                                         std::vector<char> payload;
+                                         if (workers_[w]->receive(payload) != MessageType::FITNESS)
+                                         {
+                                             throw std::runtime_error("expected FITNESS from the worker!");
+                                         }
+                                         ByteReader reader(payload);
+                                         if (reader.get<uint32_t>() != end - begin)
+                                         {
+                                             throw std::runtime_error("worker returned a wrong fitness count!");
+                                         }
+                                         for (uint32_t i = begin; i < end; i++)
+                                         {
+                                             population.get_mutable_fitness(i) = reader.get<double>();
+                                         }
+                                     }
+                                     catch (const std::exception &e)
+                                     {
+                                         errors[w] = e.what();
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        for (auto &error : errors)
+        {
+            if (!error.empty())
+            {
+                throw std::runtime_error(error);
+            }
+        }
+    }
+
+    void Coordinator::run()
+    {
+        VKCPP_TRACE_SCOPE("Coordinator::run");
+        Population &population = *strips_[strip_idx_];
+        optimizer_->next_stage(population);
+        evaluate(population);
+        optimizer_->end_stage(population);
+
+        if (optimizer_->accept(population, population.get_mutable_fitness(0)))
+        {
+            ByteWriter writer;
+            writer.put(strip_idx_);
+            population.top()->write(writer);
+            workers_[0]->send(MessageType::RENDER, writer.get_mutable_bytes());
+
+            std::vector<char> payload;
+            if (workers_[0]->receive(payload) != MessageType::ROWS)
+            {
+                throw std::runtime_error("expected ROWS from the worker!");
+            }
+            ByteReader reader(payload);
+            double fitness = reader.get<double>();
+            uint32_t y = reader.get<uint32_t>();
+            uint32_t height = reader.get<uint32_t>();
+            size_t row_size = static_cast<size_t>(extent_.width) * 4;
+            if (y + height > extent_.height)
+            {
+                throw std::runtime_error("worker rows out of the picture!");
+            }
+            reader.get_bytes(canvas_.data() + y * row_size, height * row_size);
+
+            // the rendered genome is the accepted one : its fitness is the best of the strip
+            population.set_best(fitness);
+            Picture::updateErrorMaps(strips_, data_, canvas_.data(), extent_.width, static_cast<int32_t>(y), height);
+            VkRect2D area{};
+            area.offset = {0, static_cast<int32_t>(y)};
+            area.extent = {extent_.width, height};
+            stroke_log_.append(run_count_, strip_idx_, area, *population.top());
+
+            ByteWriter delta;
+            delta.put(y);
+            delta.put(height);
+            delta.put_bytes(canvas_.data() + y * row_size, height * row_size);
+            broadcast(MessageType::CANVAS, delta.get_mutable_bytes());
+        }
+        strip_idx_ = (strip_idx_ + 1) % static_cast<uint32_t>(strips_.size());
+        run_count_++;
+    }
+
+    void Coordinator::save(const std::string &filename)
+    {
+        if (!vkcpp::encode::file(filename, canvas_.data(), extent_, extent_.width * 4, VK_FORMAT_R8G8B8A8_SRGB))
+        {
+            std::cerr << "failed to write image: " << filename << "\n";
+        }
+    }
+} // namespace painting
@@ -0,0 +1,80 @@
+#ifndef CLASS_COORDINATOR_H
+#define CLASS_COORDINATOR_H
+
+#include "batch_runner.h"
+#include "remote_protocol.h"
+
+namespace painting
+{
+    /**
+     *  Owns the painting state (strips, optimizer, canvas, stroke log) and sends the evaluation to RemoteWorkers.
+     *  A generation : the children of the current strip are split into one batch per worker (genomes only),
+     *  the fitness values come back, the accepted genome is rendered by the first worker
+     *  and its rows are sent to every worker (canvas delta).
+     */
+    class Coordinator
+    {
+    private:
+        std::vector<std::unique_ptr<Connection>> workers_;
+
+        // [strip], one island
+        std::vector<std::unique_ptr<Population>> strips_;
+
+        std::unique_ptr<Optimizer> optimizer_;
+
+        std::unique_ptr<TargetColors> target_colors_;
+
+        StrokeLog stroke_log_;
+
+        // r8g8b8a8 rows of the target
+        const char *data_{nullptr};
+
+        VkExtent3D extent_{};
+
+        std::vector<char> canvas_;
+
+        uint32_t strip_idx_{0};
+
+        uint64_t run_count_{0};
+
+        /**
+         *  @brief fitness of every genome of the population, in parallel on the workers
+         */
+        void evaluate(Population &population);
+
+        void broadcast(MessageType type, const std::vector<char> &payload);
+
+    public:
+        /**
+         *  @param addresses host:port of every worker
+         */
+        Coordinator(const char *data, const VkExtent3D &extent, const BatchJob &job, const std::vector<std::string> &addresses);
+
+        Coordinator(const Coordinator &) = delete;
+
+        ~Coordinator();
+
+        const uint32_t get_worker_count() const { return static_cast<uint32_t>(workers_.size()); }
+
+        const double get_best_fitness(uint32_t strip) const { return strips_[strip]->get_best(); }
+
+        const StrokeLog &get_stroke_log() const { return stroke_log_; }
+
+        /**
+         *  @brief default : GeneticOptimizer, call between runs
+         */
+        void set_optimizer(std::unique_ptr<Optimizer> optimizer) { optimizer_ = std::move(optimizer); }
+
+        /**
+         *  @brief one generation of the current strip, then the next strip
+         */
+        void run();
+
+        /**
+         *  @brief canvas -> png, qoi or ppm
+         */
+        void save(const std::string &filename);
+    }; // class Coordinator
+} // namespace painting
+
+#endif // #ifndef CLASS_COORDINATOR_H
@@ -0,0 +1,157 @@
+#include "error_map.h"
+#include "utility/utility.h"
+
+namespace painting
+{
+    ErrorMap::ErrorMap(const glm::vec2 &offset, const glm::vec2 &extent)
+        : offset_(offset), extent_(extent)
+    {
+        cols_ = std::max(1u, static_cast<uint32_t>(std::ceil(extent_.x / TILE_SIZE_)));
+        rows_ = std::max(1u, static_cast<uint32_t>(std::ceil(extent_.y / TILE_SIZE_)));
+        residuals_.resize(cols_ * rows_, 1.0);
+        build_alias_table();
+    }
+
+    void ErrorMap::update(const char *target, const char *canvas, uint32_t width, uint32_t channel, int32_t y, uint32_t height)
+    {
+        const unsigned char *ua = (const unsigned char *)target;
+        const unsigned char *ub = (const unsigned char *)canvas;
+        int32_t strip_x = static_cast<int32_t>(offset_.x);
+        int32_t strip_y = static_cast<int32_t>(offset_.y);
+        uint32_t line = width * channel;
+        uint32_t color_channel = std::min(channel, 3u);
+
+        // tile rows touched by [y, y + height)
+        int32_t first_row = std::max(0, (y - strip_y) / static_cast<int32_t>(TILE_SIZE_));
+        int32_t last_row = std::min(static_cast<int32_t>(rows_), (y + static_cast<int32_t>(height) - strip_y + static_cast<int32_t>(TILE_SIZE_) - 1) / static_cast<int32_t>(TILE_SIZE_));
+
+        for (int32_t row = first_row; row < last_row; row++)
+        {
+            int32_t y0 = strip_y + row * TILE_SIZE_;
+            int32_t y1 = std::min(y0 + static_cast<int32_t>(TILE_SIZE_), strip_y + static_cast<int32_t>(extent_.y));
+            for (uint32_t col = 0; col < cols_; col++)
+            {
+                int32_t x0 = strip_x + col * TILE_SIZE_;
+                int32_t x1 = std::min({x0 + static_cast<int32_t>(TILE_SIZE_), strip_x + static_cast<int32_t>(extent_.x), static_cast<int32_t>(width)});
+
+                double sum = 0.0;
+                uint32_t count = 0;
+                for (int32_t i = y0; i < y1; i++)
+                {
+                    for (int32_t j = x0; j < x1; j++)
+                    {
+                        uint32_t idx = i * line + j * channel;
+                        for (uint32_t c = 0; c < color_channel; c++)
+                        {
+                            double diff = static_cast<double>(ua[idx + c]) - static_cast<double>(ub[idx + c]);
+                            sum += diff * diff;
+                        }
+                        count++;
+                    }
+                }
+                residuals_[row * cols_ + col] = (count == 0) ? 0.0 : sum / count;
+            }
+        }
+        build_alias_table();
+    }
+
+    /*
+        Vose's alias method: https://www.keithschwarz.com/darts-dice-coins/
+    */
+    void ErrorMap::build_alias_table()
+    {
+        uint32_t n = cols_ * rows_;
+        prob_.assign(n, 1.0f);
+        alias_.resize(n);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            alias_[i] = i;
+        }
+
+        double total = 0.0;
+        for (double r : residuals_)
+        {
+            total += r;
+        }
+        if (total <= 0.0)
+        {
+            return;
+        }
+
+        std::vector<double> scaled(n);
+        std::vector<uint32_t> small;
+        std::vector<uint32_t> large;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            scaled[i] = residuals_[i] * n / total;
+            if (scaled[i] < 1.0)
+            {
+                small.push_back(i);
+            }
+            else
+            {
+                large.push_back(i);
+            }
+        }
+        while (!small.empty() && !large.empty())
+        {
+            uint32_t s = small.back();
+            uint32_t l = large.back();
+            small.pop_back();
+            large.pop_back();
+
+            prob_[s] = static_cast<float>(scaled[s]);
+            alias_[s] = l;
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+            if (scaled[l] < 1.0)
+            {
+                small.push_back(l);
+            }
+            else
+            {
+                large.push_back(l);
+            }
+        }
+        // remaining entries are 1 up to rounding
+        for (uint32_t i : small)
+        {
+            prob_[i] = 1.0f;
+        }
+        for (uint32_t i : large)
+        {
+            prob_[i] = 1.0f;
+        }
+    }
+
+    void ErrorMap::write(ByteWriter &writer) const
+    {
+        writer.put<uint32_t>(residuals_.size());
+        writer.put_bytes(reinterpret_cast<const char *>(residuals_.data()), residuals_.size() * sizeof(double));
+    }
+
+    void ErrorMap::read(ByteReader &reader)
+    {
+        if (reader.get<uint32_t>() != residuals_.size())
+        {
+            throw std::runtime_error("failed to read checkpoint! error map size");
+        }
+        reader.get_bytes(reinterpret_cast<char *>(residuals_.data()), residuals_.size() * sizeof(double));
+        build_alias_table();
+    }
+
+    glm::vec2 ErrorMap::sample(std::mt19937 &engine) const
+    {
+        uint32_t n = cols_ * rows_;
+        uint32_t tile = engine() % n;
+        if (vkcpp::getProbablity(engine) >= prob_[tile])
+        {
+            tile = alias_[tile];
+        }
+        float x0 = offset_.x + static_cast<float>((tile % cols_) * TILE_SIZE_);
+        float y0 = offset_.y + static_cast<float>((tile / cols_) * TILE_SIZE_);
+        float x1 = std::min(x0 + static_cast<float>(TILE_SIZE_), offset_.x + extent_.x);
+        float y1 = std::min(y0 + static_cast<float>(TILE_SIZE_), offset_.y + extent_.y);
+        float x = vkcpp::getRandFloat(engine, x0, x1);
+        return {x, vkcpp::getRandFloat(engine, y0, y1)};
+    }
+} // namespace painting
@@ -0,0 +1,61 @@
+#ifndef CLASS_ERROR_MAP_H
+#define CLASS_ERROR_MAP_H
+
+#include <glm/glm.hpp>
+#include "vkcpp/stdafx.h"
+#include "checkpoint.h"
+
+#include <random>
+
+namespace painting
+{
+    /**
+     *  Per-tile residuals between the canvas and the target of one strip,
+     *  positions are sampled in proportion to the residual (alias method, O(1) per sample).
+     *  Until the first update every tile has the same weight.
+     */
+    class ErrorMap
+    {
+    public:
+        static const uint32_t TILE_SIZE_ = 16;
+
+    private:
+        glm::vec2 offset_{};
+        glm::vec2 extent_{};
+        uint32_t cols_{0};
+        uint32_t rows_{0};
+
+        // mean squared error per tile
+        std::vector<double> residuals_;
+
+        // alias table
+        std::vector<float> prob_;
+        std::vector<uint32_t> alias_;
+
+        void build_alias_table();
+
+    public:
+        ErrorMap(const glm::vec2 &offset, const glm::vec2 &extent);
+
+        const uint32_t get_tile_count() const { return cols_ * rows_; }
+
+        const double get_residual(uint32_t tile) const { return residuals_[tile]; }
+
+        /**
+         *  @brief recompute the tiles overlapping rows [y, y + height) and rebuild the sampler
+         *  @param target, canvas: tightly packed images of width pixels and channel bytes per pixel
+         */
+        void update(const char *target, const char *canvas, uint32_t width, uint32_t channel, int32_t y, uint32_t height);
+
+        /**
+         *  @return a position inside the strip, uniform inside the sampled tile
+         */
+        glm::vec2 sample(std::mt19937 &engine) const;
+
+        void write(ByteWriter &writer) const;
+
+        void read(ByteReader &reader);
+    }; // class ErrorMap
+} // namespace painting
+
+#endif // #ifndef CLASS_ERROR_MAP_H
@@ -0,0 +1,321 @@
+#include "job_server.h"
+
+#include "device/physical_device.h"
+#include "utility/trace.h"
+
+#include <sstream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace painting
+{
+    JobServer::JobServer(const std::string &socket_path, uint32_t max_jobs)
+        : socket_path_(socket_path), max_jobs_(std::max(max_jobs, 1u))
+    {
+        instance_ = std::make_unique<vkcpp::Instance>(true);
+        instance_->query_gpus(nullptr);
+        std::vector<const char *> device_extensions;
+        vkcpp::PhysicalDevice *gpu = instance_->get_suitable_gpu(device_extensions);
+        device_ = std::make_unique<vkcpp::Device>(gpu);
+    }
+
+    JobServer::~JobServer()
+    {
+        stop();
+        if (device_)
+        {
+            vkDeviceWaitIdle(*device_);
+        }
+        device_.reset();
+        instance_.reset();
+    }
+
+#ifdef _WIN32
+    void JobServer::run()
+    {
+        throw std::runtime_error("unix domain sockets are not supported on this platform!");
+    }
+
+    void JobServer::stop()
+    {
+    }
+
+    void JobServer::run_worker()
+    {
+    }
+
+    void JobServer::serve(int fd, const vkcpp::CommandPool *command_pool, std::unique_ptr<Picture> &picture)
+    {
+    }
+
+    bool JobServer::sendLine(int fd, const std::string &line)
+    {
+        return false;
+    }
+
+    bool JobServer::receiveLine(int fd, std::string &line)
+    {
+        return false;
+    }
+
+    bool JobServer::isConnected(int fd)
+    {
+        return false;
+    }
+#else
+    void JobServer::run()
+    {
+        // a closed client is a failed send, not SIGPIPE
+        signal(SIGPIPE, SIG_IGN);
+        listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd_ < 0)
+        {
+            throw std::runtime_error("failed to create job server socket!");
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socket_path_.size() >= sizeof(address.sun_path))
+        {
+            throw std::runtime_error("job server socket path is too long!");
+        }
+        strncpy(address.sun_path, socket_path_.c_str(), sizeof(address.sun_path) - 1);
+        // a stale socket of a previous server
+        unlink(socket_path_.c_str());
+        if (bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listen_fd_, 16) != 0)
+        {
+            throw std::runtime_error("failed to bind job server socket: " + socket_path_);
+        }
+
+        std::vector<std::thread> workers;
+        for (uint32_t i = 0; i < max_jobs_; i++)
+        {
+            workers.emplace_back(&JobServer::run_worker, this);
+        }
+        while (true)
+        {
+            int fd = accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (is_stopped_)
+            {
+                close(fd);
+                break;
+            }
+            connections_.push_back(fd);
+            condition_.notify_one();
+        }
+        stop();
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void JobServer::stop()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (is_stopped_)
+        {
+            return;
+        }
+        is_stopped_ = true;
+        if (listen_fd_ >= 0)
+        {
+            // wakes up accept
+            shutdown(listen_fd_, SHUT_RDWR);
+            close(listen_fd_);
+            listen_fd_ = -1;
+            unlink(socket_path_.c_str());
+        }
+        for (int fd : connections_)
+        {
+            close(fd);
+        }
+        connections_.clear();
+        condition_.notify_all();
+    }
+
+    void JobServer::run_worker()
+    {
+        // kept between jobs : command pool, the last picture (pipelines stay in the registry)
+        auto command_pool = std::make_unique<vkcpp::CommandPool>(device_.get(), device_->get_graphics_queue(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+        std::unique_ptr<Picture> picture;
+        while (true)
+        {
+            int fd;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this]()
+                                { return is_stopped_ || !connections_.empty(); });
+                if (is_stopped_)
+                {
+                    break;
+                }
+                fd = connections_.front();
+                connections_.pop_front();
+            }
+            try
+            {
+                serve(fd, command_pool.get(), picture);
+            }
+            catch (const std::exception &e)
+            {
+                sendLine(fd, std::string("error ") + e.what());
+            }
+            close(fd);
+        }
+        picture.reset();
+        command_pool.reset();
+    }
+
+    void JobServer::serve(int fd, const vkcpp::CommandPool *command_pool, std::unique_ptr<Picture> &picture)
+    {
+        VKCPP_TRACE_SCOPE("JobServer::serve");
+        std::string line;
+        if (!receiveLine(fd, line))
+        {
+            return;
+        }
+        std::istringstream stream(line);
+        BatchJob job;
+        if (!BatchRunner::parseJob(stream, job))
+        {
+            sendLine(fd, "error expected: target output runs [population_size brush_count strip_count island_count [progress_interval snapshot_interval]]");
+            return;
+        }
+        uint32_t progress_interval = 10;
+        uint32_t snapshot_interval = 0;
+        stream >> progress_interval >> snapshot_interval;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        VkExtent3D extent;
+        std::vector<char> target = BatchRunner::loadTarget(job.target, extent);
+        auto next = BatchRunner::createPicture(device_.get(), command_pool, job, extent);
+        picture = std::move(next);
+        if (!sendLine(fd, "accepted " + std::to_string(job_count_++)))
+        {
+            return;
+        }
+
+        auto fitness = [&]()
+        {
+            double sum = 0.0;
+            for (uint32_t i = 0; i < picture->get_strip_count(); i++)
+            {
+                sum += picture->get_best_fitness(i);
+            }
+            return sum / picture->get_strip_count();
+        };
+        for (uint32_t run = 1; run <= job.run_count; run++)
+        {
+            // without progress lines a send never fails : the client is gone, the slot is free
+            if (!isConnected(fd))
+            {
+                return;
+            }
+            picture->run(target.data());
+            if (progress_interval > 0 && run % progress_interval == 0)
+            {
+                uint32_t stage_count = 0;
+                for (uint32_t i = 0; i < picture->get_strip_count(); i++)
+                {
+                    stage_count += picture->get_stage_count(i);
+                }
+                std::ostringstream progress;
+                progress << "progress " << run << " " << fitness() << " " << stage_count;
+                if (!sendLine(fd, progress.str()))
+                {
+                    return;
+                }
+            }
+            if (snapshot_interval > 0 && run % snapshot_interval == 0)
+            {
+                std::string filename = job.output + "_" + std::to_string(run) + ".png";
+                picture->save_snapshot(filename);
+                picture->wait_snapshot();
+                if (!sendLine(fd, "snapshot " + filename))
+                {
+                    return;
+                }
+            }
+        }
+        picture->get_stroke_log().export_json(job.output + ".json", extent);
+        picture->save_snapshot(job.output + ".png");
+        picture->wait_snapshot();
+
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        std::ostringstream done;
+        done << "done " << fitness() << " " << seconds;
+        sendLine(fd, done.str());
+    }
+
+    bool JobServer::sendLine(int fd, const std::string &line)
+    {
+        std::string message = line + "\n";
+        size_t offset = 0;
+        while (offset < message.size())
+        {
+            ssize_t size = send(fd, message.data() + offset, message.size() - offset, 0);
+            if (size <= 0)
+            {
+                return false;
+            }
+            offset += static_cast<size_t>(size);
+        }
+        return true;
+    }
+
+    bool JobServer::receiveLine(int fd, std::string &line)
+    {
+        const size_t MAX_LINE = 4096;
+        line.clear();
+        char c;
+        while (line.size() < MAX_LINE)
+        {
+            ssize_t size = recv(fd, &c, 1, 0);
+            if (size <= 0)
+            {
+                return !line.empty();
+            }
+            if (c == '\n')
+            {
+                return true;
+            }
+            line.push_back(c);
+        }
+        return true;
+    }
+
+    bool JobServer::isConnected(int fd)
+    {
+        // nothing is read after the job line : pending input is dropped, then 0 is the closed end
+        char buffer[256];
+        while (true)
+        {
+            ssize_t size = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (size > 0)
+            {
+                continue;
+            }
+            if (size == 0)
+            {
+                return false;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+    }
+#endif
+} // namespace painting
@@ -0,0 +1,77 @@
+#ifndef CLASS_JOB_SERVER_H
+#define CLASS_JOB_SERVER_H
+
+#include "batch_runner.h"
+
+#include <deque>
+#include <condition_variable>
+
+namespace painting
+{
+    /**
+     *  Painting daemon on a unix domain socket : one job per connection.
+     *
+     *  request (one line) : target output runs [population_size brush_count strip_count island_count [progress_interval snapshot_interval]]
+     *  response lines : "accepted <job>", "progress <run> <fitness> <stage_count>", "snapshot <file>",
+     *  then "done <fitness> <seconds>" or "error <message>". A closed connection cancels its job.
+     *
+     *  The device, pipelines and worker command pools live as long as the server,
+     *  at most max_jobs connections are painted at the same time, the others wait in the queue.
+     */
+    class JobServer
+    {
+    private:
+        std::unique_ptr<vkcpp::Instance> instance_;
+
+        std::unique_ptr<vkcpp::Device> device_;
+
+        std::string socket_path_;
+
+        uint32_t max_jobs_{1};
+
+        int listen_fd_{-1};
+
+        std::atomic<uint64_t> job_count_{0};
+
+        std::mutex mutex_;
+
+        std::condition_variable condition_;
+
+        // accepted connections waiting for a worker
+        std::deque<int> connections_;
+
+        bool is_stopped_{false};
+
+        void run_worker();
+
+        void serve(int fd, const vkcpp::CommandPool *command_pool, std::unique_ptr<Picture> &picture);
+
+        /**
+         *  @return false if the client is gone
+         */
+        static bool sendLine(int fd, const std::string &line);
+
+        static bool receiveLine(int fd, std::string &line);
+
+        /**
+         *  @brief non blocking : false once the client closed its end (checked every run), input after the job line is dropped
+         */
+        static bool isConnected(int fd);
+
+    public:
+        JobServer(const std::string &socket_path, uint32_t max_jobs);
+
+        JobServer(const JobServer &) = delete;
+
+        ~JobServer();
+
+        /**
+         *  @brief accept connections until stop
+         */
+        void run();
+
+        void stop();
+    }; // class JobServer
+} // namespace painting
+
+#endif // #ifndef CLASS_JOB_SERVER_H
@@ -0,0 +1,44 @@
+#ifndef CLASS_MAILBOX_H
+#define CLASS_MAILBOX_H
+
+#include "brush.h"
+
+#include <atomic>
+
+namespace painting
+{
+    /**
+     *  Lock-free single slot for migrating genomes between islands.
+     *  A newer genome replaces an unread one.
+     */
+    class Mailbox
+    {
+    private:
+        std::atomic<BrushAttributes *> slot_{nullptr};
+
+    public:
+        Mailbox() = default;
+
+        Mailbox(const Mailbox &) = delete;
+
+        ~Mailbox()
+        {
+            delete slot_.exchange(nullptr);
+        }
+
+        void send(std::unique_ptr<BrushAttributes> genome)
+        {
+            delete slot_.exchange(genome.release(), std::memory_order_acq_rel);
+        }
+
+        /**
+         *  @return nullptr if empty
+         */
+        std::unique_ptr<BrushAttributes> receive()
+        {
+            return std::unique_ptr<BrushAttributes>(slot_.exchange(nullptr, std::memory_order_acq_rel));
+        }
+    }; // class Mailbox
+} // namespace painting
+
+#endif // #ifndef CLASS_MAILBOX_H
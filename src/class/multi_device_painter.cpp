@@ -0,0 +1,110 @@
+#include "multi_device_painter.h"
+
+#include "device/physical_device.h"
+#include "utility/image_encoder.h"
+#include "utility/trace.h"
+
+namespace painting
+{
+    MultiDevicePainter::MultiDevicePainter(const char *data, const VkExtent3D &extent, const BatchJob &job, uint32_t devices_per_gpu)
+        : data_(data), extent_(extent)
+    {
+        instance_ = std::make_unique<vkcpp::Instance>(true);
+        instance_->query_gpus(nullptr);
+        std::vector<const char *> device_extensions;
+        std::vector<vkcpp::PhysicalDevice *> gpus = instance_->get_suitable_gpus(device_extensions);
+
+        // at least one row per strip of a band
+        uint32_t strip_count = std::max(job.strip_count, 1u);
+        uint32_t band_count = static_cast<uint32_t>(gpus.size()) * std::max(devices_per_gpu, 1u);
+        band_count = std::clamp(band_count, 1u, std::max(extent_.height / strip_count, 1u));
+
+        uint32_t offset_y = 0;
+        for (uint32_t i = 0; i < band_count; i++)
+        {
+            uint32_t height = extent_.height / band_count + (i < extent_.height % band_count ? 1 : 0);
+            Band band;
+            band.device = std::make_unique<vkcpp::Device>(gpus[i % gpus.size()]);
+            band.command_pool = std::make_unique<vkcpp::CommandPool>(band.device.get(), band.device->get_graphics_queue(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+            band.picture = BatchRunner::createPicture(band.device.get(), band.command_pool.get(), job, {extent_.width, height, 1});
+            band.offset_y = offset_y;
+            offset_y += height;
+            bands_.push_back(std::move(band));
+        }
+        canvas_.assign(static_cast<size_t>(extent_.width) * extent_.height * 4, static_cast<char>(255));
+    }
+
+    MultiDevicePainter::~MultiDevicePainter()
+    {
+        for (auto &band : bands_)
+        {
+            vkDeviceWaitIdle(*band.device);
+            band.picture.reset();
+            band.command_pool.reset();
+            band.device.reset();
+        }
+        instance_.reset();
+    }
+
+    void MultiDevicePainter::run(uint32_t run_count)
+    {
+        VKCPP_TRACE_SCOPE("MultiDevicePainter::run");
+        std::vector<std::thread> threads;
+        std::vector<std::string> errors(bands_.size());
+        for (size_t i = 0; i < bands_.size(); i++)
+        {
+            threads.emplace_back([this, i, run_count, &errors]()
+                                 {
+                                     Band &band = bands_[i];
+                                     const char *data = data_ + static_cast<size_t>(band.offset_y) * extent_.width * 4;
+                                     try
+                                     {
+                                         for (uint32_t run = 0; run < run_count; run++)
+                                         {
+                                             band.picture->run(data);
+                                         }
+                                     }
+                                     catch (const std::exception &e)
+                                     {
+                                         errors[i] = e.what();
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        for (auto &error : errors)
+        {
+            if (!error.empty())
+            {
+                throw std::runtime_error(error);
+            }
+        }
+    }
+
+    const std::vector<char> &MultiDevicePainter::merge_canvas()
+    {
+        VKCPP_TRACE_SCOPE("MultiDevicePainter::merge_canvas");
+        size_t row_size = static_cast<size_t>(extent_.width) * 4;
+        for (auto &band : bands_)
+        {
+            const VkExtent3D &band_extent = band.picture->get_extent_3d();
+            auto [buffer, memory, pixels, row_pitch] = band.picture->map_read_image_memory();
+            for (uint32_t y = 0; y < band_extent.height; y++)
+            {
+                memcpy(canvas_.data() + (band.offset_y + y) * row_size, pixels + y * row_pitch, row_size);
+            }
+            band.picture->unmap_buffer_memory(buffer, memory);
+        }
+        return canvas_;
+    }
+
+    void MultiDevicePainter::save(const std::string &filename)
+    {
+        merge_canvas();
+        if (!vkcpp::encode::file(filename, canvas_.data(), extent_, extent_.width * 4, VK_FORMAT_R8G8B8A8_SRGB))
+        {
+            std::cerr << "failed to write image: " << filename << "\n";
+        }
+    }
+} // namespace painting
@@ -0,0 +1,64 @@
+#ifndef CLASS_MULTI_DEVICE_PAINTER_H
+#define CLASS_MULTI_DEVICE_PAINTER_H
+
+#include "batch_runner.h"
+
+namespace painting
+{
+    /**
+     *  Paints one target on every suitable device (headless).
+     *  The rows are split into bands, one per device : a band is a Picture with its own strips,
+     *  offscreens and command pool, bands run on their own threads and merge into the host canvas.
+     */
+    class MultiDevicePainter
+    {
+    private:
+        struct Band
+        {
+            std::unique_ptr<vkcpp::Device> device;
+            std::unique_ptr<vkcpp::CommandPool> command_pool;
+            std::unique_ptr<Picture> picture;
+            uint32_t offset_y{0};
+        }; // struct Band
+
+        std::unique_ptr<vkcpp::Instance> instance_;
+
+        std::vector<Band> bands_;
+
+        // r8g8b8a8 rows of the target, the bands point into it
+        const char *data_{nullptr};
+
+        VkExtent3D extent_{};
+
+        std::vector<char> canvas_;
+
+    public:
+        /**
+         *  @param devices_per_gpu logical devices (queues) per physical device, > 1 for cpu implementations
+         */
+        MultiDevicePainter(const char *data, const VkExtent3D &extent, const BatchJob &job, uint32_t devices_per_gpu = 1);
+
+        MultiDevicePainter(const MultiDevicePainter &) = delete;
+
+        ~MultiDevicePainter();
+
+        const uint32_t get_band_count() const { return static_cast<uint32_t>(bands_.size()); }
+
+        /**
+         *  @brief run_count generations of every band, in parallel
+         */
+        void run(uint32_t run_count);
+
+        /**
+         *  @brief read back every band into the host canvas (r8g8b8a8)
+         */
+        const std::vector<char> &merge_canvas();
+
+        /**
+         *  @brief merged canvas -> png, qoi or ppm
+         */
+        void save(const std::string &filename);
+    }; // class MultiDevicePainter
+} // namespace painting
+
+#endif // #ifndef CLASS_MULTI_DEVICE_PAINTER_H
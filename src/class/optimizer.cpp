@@ -0,0 +1,74 @@
+#include "optimizer.h"
+#include "utility/utility.h"
+
+#include <cmath>
+
+namespace painting
+{
+    void Optimizer::end_stage(Population &population) const
+    {
+        population.sort();
+    }
+
+    void GeneticOptimizer::next_stage(Population &population) const
+    {
+        population.next_stage();
+    }
+    bool GeneticOptimizer::accept(Population &population, double fitness) const
+    {
+        return fitness >= population.get_best() - 0.0005;
+    }
+
+    HillClimbOptimizer::HillClimbOptimizer(float add_probablity)
+        : add_probablity_(add_probablity)
+    {
+    }
+    void HillClimbOptimizer::next_stage(Population &population) const
+    {
+        int size = population.get_size();
+        population.get_mutable_component().stage_count++;
+        // sorted : 0 is the parent
+        population.begin_children(1);
+        const BrushAttributes &parent = *population.top();
+        std::mt19937 &engine = population.get_mutable_engine();
+        for (int i = 1; i < size; i++)
+        {
+            auto child = std::make_unique<BrushAttributes>(parent);
+            population.adapt_steps(*child);
+            int attributes_size = child->get_size();
+            if (vkcpp::getProbablity(engine) < add_probablity_)
+            {
+                // new stroke on top (no-op at the stroke cap)
+                child->insert_attribute(attributes_size, engine);
+            }
+            if (child->get_size() == attributes_size && attributes_size > 0)
+            {
+                child->mutate(engine() % attributes_size, engine);
+            }
+            population.set(i, std::move(child));
+        }
+    }
+    bool HillClimbOptimizer::accept(Population &population, double fitness) const
+    {
+        return fitness > population.get_best();
+    }
+
+    AnnealingOptimizer::AnnealingOptimizer(double initial_temperature, double cooling, float add_probablity)
+        : HillClimbOptimizer(add_probablity), initial_temperature_(initial_temperature), cooling_(cooling)
+    {
+    }
+    bool AnnealingOptimizer::accept(Population &population, double fitness) const
+    {
+        double delta = fitness - population.get_best();
+        if (delta >= 0.0)
+        {
+            return true;
+        }
+        double temperature = initial_temperature_ * std::pow(cooling_, static_cast<double>(population.get_component().stage_count));
+        if (temperature <= 0.0)
+        {
+            return false;
+        }
+        return static_cast<double>(vkcpp::getProbablity(population.get_mutable_engine())) < std::exp(delta / temperature);
+    }
+} // namespace painting
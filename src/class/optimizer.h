@@ -0,0 +1,89 @@
+#ifndef CLASS_OPTIMIZER_H
+#define CLASS_OPTIMIZER_H
+
+#include "population.h"
+
+namespace painting
+{
+    /**
+     *  Per population data of an optimizer (Population::get_mutable_optimizer_state)
+     */
+    class OptimizerState
+    {
+    public:
+        virtual ~OptimizerState() = default;
+    }; // class OptimizerState
+
+    /**
+     *  Engine of Picture::run : makes the candidates of a population, orders them after the evaluation
+     *  and decides whether the best one is painted into the canvas.
+     *  Shared by the island threads, so implementations keep no mutable state :
+     *  schedules are derived from PopulationComponent::stage_count, the rest lives in an OptimizerState.
+     */
+    class Optimizer
+    {
+    public:
+        virtual ~Optimizer() = default;
+
+        /**
+         *  @brief candidates to evaluate, the population keeps its size
+         */
+        virtual void next_stage(Population &population) const = 0;
+
+        /**
+         *  @brief after the evaluation : best candidate first
+         */
+        virtual void end_stage(Population &population) const;
+
+        /**
+         *  @return the best candidate (fitness) replaces the strip of the canvas
+         */
+        virtual bool accept(Population &population, double fitness) const = 0;
+    }; // class Optimizer
+
+    /**
+     *  genetic algorithm of Population (selection, cross over, mutation)
+     */
+    class GeneticOptimizer : public Optimizer
+    {
+    public:
+        void next_stage(Population &population) const override;
+
+        bool accept(Population &population, double fitness) const override;
+    }; // class GeneticOptimizer
+
+    /**
+     *  (1 + lambda) hill climbing : the best genome is the parent of lambda = size - 1 mutants,
+     *  each adds a stroke or mutates one stroke. Only improvements are accepted.
+     */
+    class HillClimbOptimizer : public Optimizer
+    {
+    private:
+        float add_probablity_{0.5f};
+
+    public:
+        explicit HillClimbOptimizer(float add_probablity = 0.5f);
+
+        void next_stage(Population &population) const override;
+
+        bool accept(Population &population, double fitness) const override;
+    }; // class HillClimbOptimizer
+
+    /**
+     *  hill climbing proposals with the metropolis criterion,
+     *  temperature = initial_temperature * cooling ^ stage_count
+     */
+    class AnnealingOptimizer : public HillClimbOptimizer
+    {
+    private:
+        double initial_temperature_{0.001};
+        double cooling_{0.995};
+
+    public:
+        AnnealingOptimizer(double initial_temperature = 0.001, double cooling = 0.995, float add_probablity = 0.5f);
+
+        bool accept(Population &population, double fitness) const override;
+    }; // class AnnealingOptimizer
+} // namespace painting
+
+#endif // #ifndef CLASS_OPTIMIZER_H
@@ -4,10 +4,13 @@
 #include "device/queue.h"
 #include "render/image/image.h"
 #include "render/image/image2d.h"
+#include "utility/image_encoder.h"
 #include "render/render_stage.h"
 #include "render/swapchain/swapchain.h"
 #include "render/command/command_pool.h"
 #include "render/pipeline/graphics_pipeline.h"
+#include "utility/profiler.h"
+#include "utility/trace.h"
 
 namespace painting
 {
@@ -18,46 +21,44 @@ namespace painting
                      uint32_t swapchain_image_size,
                      uint32_t population_size,
                      uint32_t brush_count,
-                     uint32_t pop_count)
+                     uint32_t pop_count,
+                     uint32_t island_count)
     {
         device_ = device;
         offscreens_image_size_ = swapchain_image_size;
         extent_ = extent;
         command_pool_ = command_pool;
-
-        offscreens_ = std::make_unique<vkcpp::Offscreens>(device_, command_pool_, extent, swapchain_image_size);
-        offscreen_render_stage_ = std::make_unique<vkcpp::RenderStage>(device_, offscreens_.get());
+        population_size_ = population_size;
+        brush_count_ = brush_count;
+        // one offscreen, command buffer and fence per island
+        island_count_ = std::clamp(island_count, 1u, std::min(swapchain_image_size, MAX_FRAMES_IN_FLIGHT_));
+        optimizer_ = std::make_unique<GeneticOptimizer>();
+
+        // painting order is draw order (no depth test) : color only
+        offscreens_ = std::make_unique<vkcpp::Offscreens>(device_, command_pool_, extent, swapchain_image_size, false);
+        profile_owner_ = vkcpp::Profiler::getInstance()->create_owner();
+        offscreens_->set_profile_owner(profile_owner_);
+        // candidates : restored canvas + brushes
+        offscreen_render_stage_ = std::make_unique<vkcpp::RenderStage>(device_, offscreens_.get(), VK_ATTACHMENT_LOAD_OP_LOAD);
         render_stage_ = offscreen_render_stage_.get();
 
         command_buffers_ = std::make_unique<vkcpp::CommandBuffers>(device_, command_pool_, swapchain_image_size, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
         is_command_buffer_updated_.resize(swapchain_image_size, false);
-
-        brushes_ = std::make_unique<Brushes>(device, render_stage_, command_pool_, brush_count);
-
-        float before_height = 0.0f;
-        float height = static_cast<float>(extent.height / pop_count);
-        for (uint32_t i = 0; i < pop_count; i++)
+        timestamps_ = std::make_unique<vkcpp::QueryPool>(device_, VK_QUERY_TYPE_TIMESTAMP, 2 * swapchain_image_size);
+        statistics_ = std::make_unique<vkcpp::QueryPool>(device_,
+                                                         VK_QUERY_TYPE_PIPELINE_STATISTICS,
+                                                         swapchain_image_size,
+                                                         VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                                                             VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                                                             VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT);
+
+        brushes_ = std::make_unique<Brushes>(device, render_stage_, command_pool_, std::max(brush_count, MAX_BRUSH_COUNT_));
+
+        population_ = createStrips(extent, population_size, brush_count, pop_count, island_count_, std::random_device{}());
+        // migrants stay in their strip : its ranges and rows
+        for (size_t i = 0; i < population_.size(); i++)
         {
-            population_.push_back(std::make_unique<Population>(glm::vec2(0.0f, before_height),
-                                                               glm::vec2(static_cast<float>(extent.width), height),
-                                                               glm::vec2(0.005f, 0.05f),
-                                                               BrushAttributes::Probablity(0.8f, 0.05f, 1.0f, 0.8f),
-                                                               population_size,
-                                                               brush_count));
-            before_height += height;
-            if (i == pop_count - 2)
-            {
-                before_height += static_cast<float>(extent.height % pop_count);
-            }
-            if (i != pop_count - 1)
-            {
-                population_.push_back(std::make_unique<Population>(glm::vec2(0.0f, before_height - height / 2.0f),
-                                                                   glm::vec2(static_cast<float>(extent.width), height),
-                                                                   glm::vec2(0.005f, 0.05f),
-                                                                   BrushAttributes::Probablity(0.8f, 0.5f, 1.0f, 0.8f),
-                                                                   population_size,
-                                                                   brush_count));
-            }
+            mailboxes_.push_back(std::make_unique<Mailbox>());
         }
 
         camera_ = std::make_unique<vkcpp::SubCamera>(
@@ -72,18 +73,86 @@ namespace painting
 
         init_texture(extent, VK_FORMAT_R8G8B8A8_SRGB);
         init_object2d();
-
-        ubo_offscreens_ = std::make_unique<vkcpp::UniformBuffers<vkcpp::shader::attribute::TransformUBO>>(
-            device_,
-            texture_[current_texture_].get(),
-            framebuffers_size_);
+        // the canvas texture starts white
+        canvas_.assign(static_cast<size_t>(extent.width) * extent.height * 4, static_cast<char>(255));
 
         init_synobj();
         record_command_buffers();
     }
+
+    std::vector<std::unique_ptr<Population>> Picture::createStrips(const VkExtent3D &extent,
+                                                                  uint32_t population_size,
+                                                                  uint32_t brush_count,
+                                                                  uint32_t pop_count,
+                                                                  uint32_t island_count,
+                                                                  uint32_t seed)
+    {
+        std::vector<std::unique_ptr<Population>> strips;
+        float before_height = 0.0f;
+        float height = static_cast<float>(extent.height / pop_count);
+        for (uint32_t i = 0; i < pop_count; i++)
+        {
+            for (uint32_t j = 0; j < island_count; j++)
+            {
+                strips.push_back(std::make_unique<Population>(glm::vec2(0.0f, before_height),
+                                                              glm::vec2(static_cast<float>(extent.width), height),
+                                                              glm::vec2(0.005f, 0.05f),
+                                                              BrushAttributes::Probablity(0.8f, 0.05f, 1.0f, 0.8f),
+                                                              population_size,
+                                                              brush_count,
+                                                              seed + static_cast<uint32_t>(strips.size()),
+                                                              MAX_BRUSH_COUNT_));
+            }
+            before_height += height;
+            if (i == pop_count - 2)
+            {
+                before_height += static_cast<float>(extent.height % pop_count);
+            }
+            if (i != pop_count - 1)
+            {
+                for (uint32_t j = 0; j < island_count; j++)
+                {
+                    strips.push_back(std::make_unique<Population>(glm::vec2(0.0f, before_height - height / 2.0f),
+                                                                  glm::vec2(static_cast<float>(extent.width), height),
+                                                                  glm::vec2(0.005f, 0.05f),
+                                                                  BrushAttributes::Probablity(0.8f, 0.5f, 1.0f, 0.8f),
+                                                                  population_size,
+                                                                  brush_count,
+                                                                  seed + static_cast<uint32_t>(strips.size()),
+                                                                  MAX_BRUSH_COUNT_));
+                }
+            }
+        }
+        return strips;
+    }
+
+    void Picture::updateErrorMaps(std::vector<std::unique_ptr<Population>> &populations,
+                                  const char *target,
+                                  const char *canvas,
+                                  uint32_t width,
+                                  int32_t y,
+                                  uint32_t height)
+    {
+        // half-offset strips overlap their neighbours : every map of the rows is stale
+        for (auto &population : populations)
+        {
+            const PopulationComponent &component = population->get_component();
+            int32_t top = static_cast<int32_t>(component.offset.y);
+            int32_t bottom = static_cast<int32_t>(component.offset.y + component.extent.y);
+            if (top < y + static_cast<int32_t>(height) && y < bottom)
+            {
+                population->get_mutable_error_map().update(target, canvas, width, 4, y, height);
+            }
+        }
+    }
+
     Picture::~Picture()
     {
         wait_thread();
+        checkpoint_.wait();
+        exporter_.reset();
+        timelapse_.reset();
+        vkcpp::Profiler::getInstance()->release_owner(profile_owner_);
 
         for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT_; i++)
         {
@@ -100,20 +169,22 @@ namespace painting
         {
             population_[i].reset();
         }
-        ubo_offscreens_.reset();
         offscreen_render_stage_.reset();
         offscreens_.reset();
+        statistics_.reset();
+        timestamps_.reset();
         command_buffers_.reset();
     }
     void Picture::wait_thread()
     {
-        for (uint32_t i = 0; i < MAX_THREAD_; i++)
+        for (auto &thread : island_threads_)
         {
-            //      if (frame_thread_[i].joinable())
+            if (thread.joinable())
             {
-                //        frame_thread_[i].join();
+                thread.join();
             }
         }
+        island_threads_.clear();
     }
     void Picture::record_command_buffers()
     {
@@ -125,95 +196,476 @@ namespace painting
 
     void Picture::record_command_buffer(int idx)
     {
+        VkCommandBuffer command_buffer = (*command_buffers_)[idx];
+
         command_buffers_->begin_command_buffer(idx, 0);
 
-        command_buffers_->begin_render_pass(idx, render_stage_);
+        timestamps_->reset(command_buffer, 2 * idx, 2);
+        statistics_->reset(command_buffer, idx, 1);
+        timestamps_->write_timestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 2 * idx);
+        statistics_->begin(command_buffer, idx);
 
-        draw((*command_buffers_)[idx], ubo_offscreens_.get(), idx);
+        // candidates only change the strip
+        VkRect2D strip_area = get_strip_area(pop_idx_);
+        offscreens_->get_mutable_offscreen(idx).cmd_restore(command_buffer, get_image(), strip_area);
 
-        brushes_->draw_all((*command_buffers_)[idx], idx);
+        command_buffers_->begin_render_pass(idx, render_stage_, strip_area);
+
+        brushes_->draw_all(command_buffer, idx);
 
         command_buffers_->end_render_pass(idx, render_stage_);
 
+        statistics_->end(command_buffer, idx);
+        timestamps_->write_timestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 2 * idx + 1);
+
         command_buffers_->end_command_buffer(idx);
         is_command_buffer_updated_[idx] = true;
     }
 
+    VkRect2D Picture::get_strip_area(uint32_t pop_idx) const
+    {
+        const PopulationComponent &component = population_[pop_idx * island_count_]->get_component();
+        int32_t y0 = std::max(static_cast<int32_t>(component.offset.y), 0);
+        int32_t y1 = std::min(static_cast<int32_t>(std::ceil(component.offset.y + component.extent.y)), static_cast<int32_t>(extent_.height));
+
+        VkRect2D area{};
+        area.offset = {0, y0};
+        area.extent = {extent_.width, static_cast<uint32_t>(std::max(y1 - y0, 0))};
+        return area;
+    }
+
     void Picture::run(const char *data)
     {
-        current_frame_ = image_index_ = 0;
-        int size = population_[pop_idx_]->get_size();
-        population_[pop_idx_]->next_stage();
+        VKCPP_TRACE_SCOPE("Picture::run");
+        if (!target_colors_)
+        {
+            init_target_colors(data);
+        }
+        if (timelapse_interval_ > 0 && !timelapse_)
+        {
+            timelapse_ = std::make_unique<vkcpp::TimelapseWriter>(timelapse_filename_, extent_, timelapse_fps_, data);
+        }
+        // the strip changed : re-record (every submission is completed here)
+        // the command pool is not thread safe : islands only submit
+        std::fill(is_command_buffer_updated_.begin(), is_command_buffer_updated_.end(), false);
+        for (uint32_t i = 0; i < island_count_; i++)
+        {
+            record_command_buffer(i);
+        }
+
+        if (island_count_ == 1)
+        {
+            run_island(0, data);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < island_count_; i++)
+            {
+                island_threads_.emplace_back(&Picture::run_island, this, i, data);
+            }
+            wait_thread();
+        }
+
+        uint32_t best_island = 0;
+        for (uint32_t i = 1; i < island_count_; i++)
+        {
+            if (get_island(i).get_mutable_fitness(0) > get_island(best_island).get_mutable_fitness(0))
+            {
+                best_island = i;
+            }
+        }
+
+        Population &best_population = get_island(best_island);
+        if (optimizer_->accept(get_island(0), best_population.get_mutable_fitness(0)))
+        {
+            draw_frame(best_island, 0, data, true);
+            vkWaitForFences(*device_, 1, &in_flight_fences_[best_island], VK_TRUE, UINT64_MAX);
+            profile_command_buffer(best_island);
+            double best_fit = best_population.get_mutable_fitness(0);
+            VkRect2D strip_area = get_strip_area(pop_idx_);
+            stroke_log_.append(run_count_, pop_idx_, strip_area, *best_population.top());
+            vkcpp::Offscreen &offscreen = offscreens_->get_mutable_offscreen(best_island);
+            {
+                // the accepted render is the new canvas of the strip (only the strip rows are valid)
+                const char *canvas = offscreen.map_image_memory();
+                size_t row_size = static_cast<size_t>(extent_.width) * 4;
+                size_t begin = strip_area.offset.y * row_size;
+                std::copy(canvas + begin, canvas + begin + strip_area.extent.height * row_size, canvas_.begin() + begin);
+                offscreen.unmap_memory();
+            }
+            for (uint32_t i = 0; i < island_count_; i++)
+            {
+                get_island(i).set_best(best_fit);
+            }
+            updateErrorMaps(population_, data, canvas_.data(), extent_.width, strip_area.offset.y, strip_area.extent.height);
+            offscreen.screen_to_image(command_pool_,
+                                      get_image(),
+                                      {strip_area.extent.width, strip_area.extent.height, 1},
+                                      {strip_area.offset.x, strip_area.offset.y, 0},
+                                      VK_FORMAT_B8G8R8A8_SRGB);
+            accepted_count_++;
+            if (timelapse_ && accepted_count_ % timelapse_interval_ == 0)
+            {
+                vkcpp::ScopeTimer timer("timelapse", profile_owner_);
+                auto [buffer, memory, canvas, row_pitch] = map_read_image_memory();
+                timelapse_->add_frame(canvas, row_pitch, VK_FORMAT_R8G8B8A8_SRGB);
+                unmap_buffer_memory(buffer, memory);
+            }
+        }
+        const MutationStatistics &statistics = get_island(0).get_statistics();
+        vkcpp::Profiler *profiler = vkcpp::Profiler::getInstance();
+        profiler->set_value(profile_owner_, "success_rate", statistics.running_success_rate);
+        profiler->set_value(profile_owner_, "step_translation", statistics.mean_step.translation);
+        profiler->set_value(profile_owner_, "step_scale", statistics.mean_step.scale);
+        profiler->set_value(profile_owner_, "step_rotation", statistics.mean_step.rotation);
+        profiler->set_value(profile_owner_, "step_color", statistics.mean_step.color);
+        profiler->end_generation(profile_owner_, pop_idx_);
+        pop_idx_ = (1 + pop_idx_) % get_strip_count();
+
+        if (target_hash_ == 0)
+        {
+            target_hash_ = Checkpoint::hashBytes(data, extent_.width * extent_.height * 4);
+        }
+        run_count_++;
+        if (checkpoint_interval_ > 0 && run_count_ % checkpoint_interval_ == 0)
+        {
+            save_checkpoint();
+        }
+        if (snapshot_interval_ > 0 && run_count_ % snapshot_interval_ == 0)
+        {
+            save_snapshot(snapshot_prefix_ + std::to_string(run_count_) + snapshot_extension_);
+        }
+    }
+
+    bool Picture::replay(const VkExtent3D &output_extent, const char *filename)
+    {
+        VKCPP_TRACE_SCOPE("Picture::replay");
+        int stroke_count = static_cast<int>(stroke_log_.get_stroke_count());
+        if (stroke_count == 0)
+        {
+            return false;
+        }
+        vkcpp::ScopeTimer timer("replay", profile_owner_);
+        vkcpp::Offscreens offscreens(device_, command_pool_, output_extent, 1, false);
+        vkcpp::RenderStage render_stage(device_, &offscreens);
+        render_stage.set_clear_color({{1.0f, 1.0f, 1.0f, 1.0f}});
+        Brushes brushes(device_, &render_stage, command_pool_, stroke_count);
+
+        // the camera maps picture pixels, the viewport scales them to the output
+        int idx = 0;
+        for (auto &record : stroke_log_.get_records())
+        {
+            for (auto &stroke : record.strokes)
+            {
+                brushes.update(stroke, camera_.get(), idx++, 0);
+            }
+        }
+        brushes.set_draw_count(stroke_count, 0);
+
+        vkcpp::CommandBuffers command_buffers(device_, command_pool_, 1, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+        command_buffers.begin_command_buffer(0, 0);
+        command_buffers.begin_render_pass(0, &render_stage);
+        // every record is clipped to its strip, as when it was accepted (edges rounded : strips stay adjacent)
+        float scale_x = static_cast<float>(output_extent.width) / width_;
+        float scale_y = static_cast<float>(output_extent.height) / height_;
+        int first = 0;
+        for (auto &record : stroke_log_.get_records())
+        {
+            int32_t x0 = static_cast<int32_t>(std::lround(record.area.offset.x * scale_x));
+            int32_t y0 = static_cast<int32_t>(std::lround(record.area.offset.y * scale_y));
+            int32_t x1 = static_cast<int32_t>(std::lround((record.area.offset.x + record.area.extent.width) * scale_x));
+            int32_t y1 = static_cast<int32_t>(std::lround((record.area.offset.y + record.area.extent.height) * scale_y));
+            VkRect2D scissor{};
+            scissor.offset = {x0, y0};
+            scissor.extent = {static_cast<uint32_t>(std::max(x1 - x0, 0)), static_cast<uint32_t>(std::max(y1 - y0, 0))};
+            vkCmdSetScissor(command_buffers[0], 0, 1, &scissor);
+            int count = static_cast<int>(record.strokes.size());
+            brushes.draw_range(command_buffers[0], 0, first, count);
+            first += count;
+        }
+        command_buffers.end_render_pass(0, &render_stage);
+        command_buffers.flush_command_buffer(0);
+
+        vkcpp::Offscreen &offscreen = offscreens.get_mutable_offscreen(0);
+        const char *pixels = offscreen.map_image_memory();
+        vkcpp::encode::file(filename, pixels, output_extent, output_extent.width * 4, VK_FORMAT_R8G8B8A8_SRGB);
+        offscreen.unmap_memory();
+        return true;
+    }
+
+    void Picture::init_target_colors(const char *data)
+    {
+        target_colors_ = std::make_unique<TargetColors>(data, extent_.width, extent_.height, brushes_->get_region_half_extents());
+        for (auto &population : population_)
+        {
+            population->set_target_colors(target_colors_.get());
+        }
+        // residuals of the whole canvas : strips sample where it differs before they accept
+        updateErrorMaps(population_, data, canvas_.data(), extent_.width, 0, extent_.height);
+    }
+
+    void Picture::set_checkpoint(const std::string &filename, uint32_t interval)
+    {
+        checkpoint_filename_ = filename;
+        checkpoint_interval_ = interval;
+    }
 
-        init_transform({width_ / 2.0f, height_ / 2.0f, -90.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f});
+    void Picture::set_snapshot(const std::string &prefix, const std::string &extension, uint32_t interval)
+    {
+        snapshot_prefix_ = prefix;
+        snapshot_extension_ = extension;
+        snapshot_interval_ = interval;
+    }
+
+    void Picture::set_timelapse(const std::string &filename, uint32_t interval, uint32_t fps)
+    {
+        timelapse_.reset();
+        timelapse_filename_ = filename;
+        timelapse_interval_ = interval;
+        timelapse_fps_ = fps;
+    }
+
+    void Picture::save_snapshot(const std::string &filename)
+    {
+        vkcpp::ScopeTimer timer("snapshot", profile_owner_);
+        if (!exporter_)
+        {
+            exporter_ = std::make_unique<vkcpp::ImageExporter>(device_, command_pool_, extent_, VK_FORMAT_R8G8B8A8_SRGB);
+        }
+        exporter_->snapshot(get_image(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, filename);
+    }
+
+    void Picture::wait_snapshot()
+    {
+        if (exporter_)
+        {
+            exporter_->wait();
+        }
+    }
+
+    void Picture::save_checkpoint()
+    {
+        VKCPP_TRACE_SCOPE("Picture::save_checkpoint");
+        vkcpp::ScopeTimer timer("checkpoint", profile_owner_);
+        ByteWriter writer;
+        writer.put(Checkpoint::MAGIC_);
+        writer.put(Checkpoint::VERSION_);
+        writer.put(extent_.width);
+        writer.put(extent_.height);
+        writer.put(get_strip_count());
+        writer.put(island_count_);
+        writer.put(population_size_);
+        writer.put(brush_count_);
+        writer.put(target_hash_);
+        writer.put(pop_idx_);
+        writer.put(run_count_);
+        writer.put(accepted_count_);
+
+        auto [buffer, memory, canvas, row_pitch] = map_read_image_memory();
+        writer.put_bytes(canvas, extent_.width * extent_.height * 4);
+        unmap_buffer_memory(buffer, memory);
+
+        for (auto &population : population_)
+        {
+            population->write(writer);
+        }
+        // islands are joined : a migrant not received yet is put back
+        for (auto &mailbox : mailboxes_)
+        {
+            std::unique_ptr<BrushAttributes> migrant = mailbox->receive();
+            writer.put<uint32_t>(migrant ? 1 : 0);
+            if (migrant)
+            {
+                migrant->write(writer);
+                mailbox->send(std::move(migrant));
+            }
+        }
+        stroke_log_.write(writer);
+        checkpoint_.write_async(checkpoint_filename_, std::move(writer.get_mutable_bytes()));
+    }
+
+    bool Picture::load_checkpoint(const std::string &filename, const char *data)
+    {
+        std::vector<char> bytes;
+        if (!Checkpoint::readFile(filename, bytes))
+        {
+            return false;
+        }
+        ByteReader reader(bytes);
+        if (reader.get<uint32_t>() != Checkpoint::MAGIC_ || reader.get<uint32_t>() != Checkpoint::VERSION_)
+        {
+            std::cerr << "unknown checkpoint format: " << filename << "\n";
+            return false;
+        }
+        uint64_t target_hash = Checkpoint::hashBytes(data, extent_.width * extent_.height * 4);
+        if (reader.get<uint32_t>() != extent_.width ||
+            reader.get<uint32_t>() != extent_.height ||
+            reader.get<uint32_t>() != get_strip_count() ||
+            reader.get<uint32_t>() != island_count_ ||
+            reader.get<uint32_t>() != population_size_ ||
+            reader.get<uint32_t>() != brush_count_ ||
+            reader.get<uint64_t>() != target_hash)
+        {
+            std::cerr << "checkpoint of another target or config: " << filename << "\n";
+            return false;
+        }
+        // reseeds the current genomes : before they are read
+        init_target_colors(data);
+        target_hash_ = target_hash;
+        pop_idx_ = reader.get<uint32_t>();
+        run_count_ = reader.get<uint64_t>();
+        accepted_count_ = reader.get<uint64_t>();
+
+        std::vector<char> canvas(extent_.width * extent_.height * 4);
+        reader.get_bytes(canvas.data(), canvas.size());
+        sub_texture_pixels(canvas.data(), canvas.size());
+        canvas_ = canvas;
+
+        for (auto &population : population_)
+        {
+            population->read(reader);
+        }
+        // a migrant is the best of the previous island of the same strip : its ranges are that population's
+        for (size_t i = 0; i < mailboxes_.size(); i++)
+        {
+            mailboxes_[i]->receive();
+            if (reader.get<uint32_t>() != 0)
+            {
+                size_t strip = i / island_count_;
+                size_t island = (i % island_count_ + island_count_ - 1) % island_count_;
+                auto migrant = std::make_unique<BrushAttributes>(*population_[strip * island_count_ + island]->top());
+                migrant->read(reader);
+                mailboxes_[i]->send(std::move(migrant));
+            }
+        }
+        stroke_log_.read(reader);
+        std::fill(is_command_buffer_updated_.begin(), is_command_buffer_updated_.end(), false);
+        return true;
+    }
+
+    void Picture::run_island(uint32_t island, const char *data)
+    {
+        VKCPP_TRACE_SCOPE("Picture::run_island");
+        Population &population = get_island(island);
+        int size = population.get_size();
+        {
+            vkcpp::ScopeTimer timer("next_stage", profile_owner_);
+            optimizer_->next_stage(population);
+        }
+        // immigrant of the previous island is evaluated with the children
+        std::unique_ptr<BrushAttributes> immigrant = mailboxes_[pop_idx_ * island_count_ + island]->receive();
+        if (immigrant)
+        {
+            population.replace_worst(std::move(immigrant));
+        }
 
         for (int i = 0; i < size; i++)
         {
-            draw_frame(i, data, false);
-            // current_frame_ = (current_frame_ + 1) % MAX_FRAMES_IN_FLIGHT_;
-            //  image_index_ = (image_index_ + 1) % offscreens_image_size_;
+            draw_frame(island, i, data, false);
+        }
+        {
+            vkcpp::ScopeTimer timer("sort", profile_owner_);
+            optimizer_->end_stage(population);
         }
-        wait_thread();
-        population_[pop_idx_]->sort();
 
-        if (population_[pop_idx_]->get_mutable_fitness(0) >= population_[pop_idx_]->get_best() - 0.0005)
+        if (island_count_ > 1 && population.get_component().stage_count % MIGRATION_INTERVAL_ == 0)
         {
-            draw_frame(0, data, true);
-            vkQueueWaitIdle(*device_->get_graphics_queue());
-            population_[pop_idx_]->set_best(population_[pop_idx_]->get_mutable_fitness(0));
-            offscreens_->get_mutable_offscreen(image_index_).screen_to_image(command_pool_, get_image(), extent_, {0, 0, 0}, VK_FORMAT_B8G8R8A8_SRGB);
+            mailboxes_[pop_idx_ * island_count_ + (island + 1) % island_count_]->send(std::make_unique<BrushAttributes>(*population.top()));
         }
-        pop_idx_ = (1 + pop_idx_) % population_.size();
     }
 
-    void Picture::draw_frame(int population_idx, const char *data, bool is_top)
+    double Picture::evaluate(uint32_t strip, const char *data, std::vector<char> *rows, VkRect2D *area)
     {
-        /*
-        if (frame_thread_[image_index_].joinable())
+        VKCPP_TRACE_SCOPE("Picture::evaluate");
+        if (pop_idx_ != strip)
+        {
+            pop_idx_ = strip;
+            is_command_buffer_updated_[0] = false;
+        }
+        draw_frame(0, 0, data, false);
+        if (rows != nullptr)
         {
-            frame_thread_[image_index_].join();
+            VkRect2D strip_area = get_strip_area(pop_idx_);
+            vkcpp::Offscreen &offscreen = offscreens_->get_mutable_offscreen(0);
+            const char *canvas = offscreen.map_image_memory();
+            size_t row_size = static_cast<size_t>(extent_.width) * 4;
+            rows->assign(canvas + strip_area.offset.y * row_size, canvas + (strip_area.offset.y + strip_area.extent.height) * row_size);
+            offscreen.unmap_memory();
+            if (area != nullptr)
+            {
+                *area = strip_area;
+            }
         }
-       */
-        update_with_sub_camera(ubo_offscreens_.get(), image_index_, camera_.get());
+        return get_island(0).get_mutable_fitness(0);
+    }
 
-        int brushes_size = brushes_->get_brushes_size();
+    void Picture::draw_frame(uint32_t island, int population_idx, const char *data, bool is_top)
+    {
+        VKCPP_TRACE_SCOPE("Picture::draw_frame");
+        // island i : command buffer, offscreen, brush slots and fence i
+        if (!is_command_buffer_updated_[island])
+        {
+            record_command_buffer(island);
+        }
+        Population &population = get_island(island);
+        BrushAttributes *attributes = population.get(population_idx);
+        int brushes_size = std::min(brushes_->get_brushes_size(), attributes->get_size());
         for (int i = 0; i < brushes_size; i++)
         {
-            brushes_->update(population_[pop_idx_]->get(population_idx)->get_attribute(i), camera_.get(), i, image_index_);
+            brushes_->update(attributes->get_attribute(i), camera_.get(), i, island);
         }
+        brushes_->set_draw_count(brushes_size, island);
 
         VkSubmitInfo submitInfo{};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
         submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &(*command_buffers_)[image_index_];
+        submitInfo.pCommandBuffers = &(*command_buffers_)[island];
 
-        vkResetFences(*device_, 1, &in_flight_fences_[current_frame_]);
-        device_->graphics_queue_submit(&submitInfo, 1, in_flight_fences_[current_frame_], "failed to picture queue submit");
+        vkResetFences(*device_, 1, &in_flight_fences_[island]);
+        device_->graphics_queue_submit(&submitInfo, 1, in_flight_fences_[island], "failed to picture queue submit");
 
-        // TODO thread 가 적절히 사용되었는지?
         if (!is_top)
         {
-            /*
-            frame_thread_[image_index_] = std::thread(caculate_fun,
-                                                      device_,
-                                                      &offscreens_->get_mutable_offscreen(image_index_),
-                                                      data,
-                                                      &population_->get_mutable_fitness(population_idx),
-                                                      &in_flight_fences_[current_frame_]);
-                                                      */
-            vkcpp::Offscreen *offscreen = &offscreens_->get_mutable_offscreen(image_index_);
+            vkcpp::Offscreen *offscreen = &offscreens_->get_mutable_offscreen(island);
             const VkExtent3D &extent = offscreen->get_extent();
 
-            vkWaitForFences(*device_, 1, &in_flight_fences_[current_frame_], VK_TRUE, UINT64_MAX);
+            {
+                VKCPP_TRACE_SCOPE("wait_fence");
+                vkWaitForFences(*device_, 1, &in_flight_fences_[island], VK_TRUE, UINT64_MAX);
+            }
+            profile_command_buffer(island);
             const char *data2 = offscreen->map_image_memory();
 
-            auto tmp_pop_component = population_[pop_idx_]->get_component();
-            population_[pop_idx_]->get_mutable_fitness(population_idx) = fitnessFunction(data, data2, 0, tmp_pop_component.offset.y, extent.width, tmp_pop_component.extent.y, 4, false);
+            const PopulationComponent &component = population.get_component();
+            {
+                VKCPP_TRACE_SCOPE("fitness");
+                vkcpp::ScopeTimer timer("fitness", profile_owner_);
+                population.get_mutable_fitness(population_idx) = fitnessFunction(data, data2, 0, component.offset.y, extent.width, component.extent.y, 4, false);
+            }
             offscreen->unmap_memory();
         }
     }
 
+    void Picture::profile_command_buffer(int idx)
+    {
+        vkcpp::Profiler *profiler = vkcpp::Profiler::getInstance();
+        if (!profiler->is_enabled())
+        {
+            return;
+        }
+        profiler->add_gpu(profile_owner_, "render", timestamps_->get_elapsed_ms(2 * idx));
+
+        std::vector<uint64_t> statistics;
+        if (statistics_->get_results(idx, 1, statistics))
+        {
+            // ordered by bit
+            profiler->add_counter(profile_owner_, "vs_invocations", statistics[0]);
+            profiler->add_counter(profile_owner_, "clipping_primitives", statistics[1]);
+            profiler->add_counter(profile_owner_, "fs_invocations", statistics[2]);
+        }
+    }
+
     void Picture::caculate_fun(const vkcpp::Device *device,
                                vkcpp::Offscreen *offscreen,
                                const char *data,
@@ -5,7 +5,14 @@
 #include "render/swapchain/offscreens.h"
 #include "render/render_stage.h"
 #include "render/command/command_buffers.h"
+#include "render/command/query_pool.h"
+#include "render/image/image_exporter.h"
+#include "utility/timelapse_writer.h"
 #include "population.h"
+#include "mailbox.h"
+#include "optimizer.h"
+#include "checkpoint.h"
+#include "stroke_log.h"
 #include "object/camera/sub_camera.h"
 
 #include "stdafx.h"
@@ -16,10 +23,15 @@ namespace painting
     {
 
         static const uint32_t MAX_FRAMES_IN_FLIGHT_ = 3;
+        // stroke cap of a genome (brushes recorded per command buffer)
+        static const uint32_t MAX_BRUSH_COUNT_ = 16;
         static const uint32_t MAX_THREAD_ = MAX_FRAMES_IN_FLIGHT_;
-        //    std::thread frame_thread_[MAX_THREAD_];
+        // generations between migrations of the best genome to the next island
+        static const uint32_t MIGRATION_INTERVAL_ = 5;
+        std::vector<std::thread> island_threads_;
         uint32_t thread_index_ = 0;
         uint32_t pop_idx_ = 0;
+        uint32_t island_count_ = 1;
 
     public:
         static void caculate_fun(const vkcpp::Device *device,
@@ -33,10 +45,43 @@ namespace painting
         std::unique_ptr<vkcpp::Offscreens> offscreens_{};
         std::unique_ptr<vkcpp::RenderStage> offscreen_render_stage_{nullptr};
         std::unique_ptr<vkcpp::CommandBuffers> command_buffers_{};
+        // 2 timestamps (begin, end) and 1 statistics query per command buffer
+        std::unique_ptr<vkcpp::QueryPool> timestamps_{nullptr};
+        std::unique_ptr<vkcpp::QueryPool> statistics_{nullptr};
+        // [strip * island_count_ + island]
         std::vector<std::unique_ptr<Population>> population_;
+        // mailbox of each island (ring per strip), [strip * island_count + island]
+        std::vector<std::unique_ptr<Mailbox>> mailboxes_;
+        std::unique_ptr<Optimizer> optimizer_;
+
+        Checkpoint checkpoint_;
+        std::string checkpoint_filename_;
+        // runs between checkpoints (0 : disabled)
+        uint32_t checkpoint_interval_{0};
+        uint64_t run_count_{0};
+        // entries of this painting in vkcpp::Profiler
+        uint32_t profile_owner_{0};
+        // canvas snapshots encoded on background threads
+        std::unique_ptr<vkcpp::ImageExporter> exporter_;
+        std::string snapshot_prefix_;
+        std::string snapshot_extension_;
+        // runs between snapshots (0 : disabled)
+        uint32_t snapshot_interval_{0};
+        // canvas frame every interval accepted generations, opened on the first run
+        std::unique_ptr<vkcpp::TimelapseWriter> timelapse_;
+        std::string timelapse_filename_;
+        uint32_t timelapse_interval_{0};
+        uint32_t timelapse_fps_{10};
+        uint64_t accepted_count_{0};
+        uint64_t target_hash_{0};
+        uint32_t population_size_{0};
+        uint32_t brush_count_{0};
+        // accepted winners in painting order
+        StrokeLog stroke_log_;
         std::unique_ptr<Brushes> brushes_;
+        // summed-area table of the target, built on the first run
+        std::unique_ptr<TargetColors> target_colors_;
         std::unique_ptr<vkcpp::SubCamera> camera_;
-        std::unique_ptr<vkcpp::UniformBuffers<vkcpp::shader::attribute::TransformUBO>> ubo_offscreens_{nullptr};
 
         std::vector<bool> is_command_buffer_updated_;
 
@@ -44,13 +89,13 @@ namespace painting
         float width_;
         float height_;
         uint32_t offscreens_image_size_{0};
+        // host copy of the canvas (r8g8b8a8), residuals of the error maps are taken against it
+        std::vector<char> canvas_;
 
         std::vector<VkSemaphore> image_available_semaphores_;
         std::vector<VkSemaphore> render_finished_semaphores_;
         std::vector<VkFence> in_flight_fences_;
         std::vector<VkFence> images_in_flight_;
-        int current_frame_{0};
-        int image_index_{0};
 
     public:
         Picture(const vkcpp::Device *device,
@@ -60,22 +105,141 @@ namespace painting
                 uint32_t swapchain_image_size,
                 uint32_t population_size,
                 uint32_t brush_count,
-                uint32_t pop_count);
+                uint32_t pop_count,
+                uint32_t island_count = 1);
         virtual ~Picture();
 
+        /**
+         *  @brief pop_count strips and the half-offset strips between them, island_count populations each
+         *  @param seed population [i] draws from its own engine, seeded with seed + i
+         *  @return [strip * island_count + island]
+         */
+        static std::vector<std::unique_ptr<Population>> createStrips(const VkExtent3D &extent,
+                                                                     uint32_t population_size,
+                                                                     uint32_t brush_count,
+                                                                     uint32_t pop_count,
+                                                                     uint32_t island_count,
+                                                                     uint32_t seed);
+
+        /**
+         *  @brief refresh the error map of every population overlapping rows [y, y + height)
+         *  @param target, canvas r8g8b8a8 pictures of width pixels
+         */
+        static void updateErrorMaps(std::vector<std::unique_ptr<Population>> &populations,
+                                    const char *target,
+                                    const char *canvas,
+                                    uint32_t width,
+                                    int32_t y,
+                                    uint32_t height);
+
         Brushes &get_mutable_brushes() { return *brushes_; }
 
-        Population &get_mutable_population() { return *population_[pop_idx_]; }
+        Population &get_mutable_population() { return get_island(0); }
+
+        /**
+         *  @brief default : GeneticOptimizer, call between runs
+         */
+        void set_optimizer(std::unique_ptr<Optimizer> optimizer) { optimizer_ = std::move(optimizer); }
+
+        Population &get_island(uint32_t island) { return *population_[pop_idx_ * island_count_ + island]; }
+
+        const uint32_t get_strip_count() const { return population_.size() / island_count_; }
+
+        const uint32_t get_island_count() const { return island_count_; }
+
+        const double get_best_fitness(uint32_t strip) const { return population_[strip * island_count_]->get_best(); }
+
+        const uint32_t get_stage_count(uint32_t strip) const { return population_[strip * island_count_]->get_component().stage_count; }
+
+        const MutationStatistics &get_mutation_statistics(uint32_t strip, uint32_t island = 0) const { return population_[strip * island_count_ + island]->get_statistics(); }
+
+        const StrokeLog &get_stroke_log() const { return stroke_log_; }
 
         void run(const char *data);
 
+        /**
+         *  @brief re-render the stroke log over a white canvas with one submission, write a png, qoi or ppm
+         *  @return false if the log is empty
+         */
+        bool replay(const VkExtent3D &output_extent, const char *filename);
+
+        /**
+         *  @brief summed-area table of the target, seeds the colors of the current and new strokes,
+         *  error maps from the current canvas
+         */
+        void init_target_colors(const char *data);
+
+        /**
+         *  @brief write a checkpoint every interval runs on a background thread
+         */
+        void set_checkpoint(const std::string &filename, uint32_t interval);
+
+        /**
+         *  @brief write the canvas to prefix + run count + extension every interval runs
+         *  @param extension .png, .qoi or .ppm
+         */
+        void set_snapshot(const std::string &prefix, const std::string &extension, uint32_t interval);
+
+        /**
+         *  @brief stream a time-lapse (.gif, palette of the target, or .y4m) with a frame every interval accepted generations
+         */
+        void set_timelapse(const std::string &filename, uint32_t interval, uint32_t fps);
+
+        /**
+         *  @brief canvas readback on this thread, encode and write on the exporter thread
+         */
+        void save_snapshot(const std::string &filename);
+
+        /**
+         *  @brief wait until every snapshot is written
+         */
+        void wait_snapshot();
+
+        /**
+         *  @brief snapshot (canvas readback, populations) on this thread, file write on the checkpoint thread
+         */
+        void save_checkpoint();
+
+        /**
+         *  @brief restore the canvas, populations and rng, call before the first run
+         *  @return false if there is no checkpoint or it belongs to another target or config
+         */
+        bool load_checkpoint(const std::string &filename, const char *data);
+
         void record_command_buffers();
 
         void record_command_buffer(int idx);
 
+        /**
+         *  @return rows of the population strip, clamped to the picture
+         */
+        VkRect2D get_strip_area(uint32_t pop_idx) const;
+
         void init_synobj();
 
-        void draw_frame(int population_idx, const char *data, bool is_top);
+        /**
+         *  @brief one generation of an island of the current strip (worker thread)
+         */
+        void run_island(uint32_t island, const char *data);
+
+        void draw_frame(uint32_t island, int population_idx, const char *data, bool is_top);
+
+        /**
+         *  @brief genome slot of remote evaluation (first genome of the strip)
+         */
+        BrushAttributes &get_mutable_genome(uint32_t strip) { return *population_[strip * island_count_]->get(0); }
+
+        /**
+         *  @brief fitness of the genome slot of the strip on the current canvas
+         *  @param rows if not null : the rendered rows of the strip area (r8g8b8a8), area is returned
+         */
+        double evaluate(uint32_t strip, const char *data, std::vector<char> *rows = nullptr, VkRect2D *area = nullptr);
+
+        /**
+         *  @brief gpu render time and pipeline statistics of the command buffer -> Profiler
+         *  the command buffer must be completed
+         */
+        void profile_command_buffer(int idx);
     };
 }
 double fitnessFunction(const char *a, const char *b, int posx, int posy, int width, int height, int channel, bool is_gray);
@@ -1,6 +1,9 @@
 #include "population.h"
+#include "optimizer.h"
 #include "utility/utility.h"
 
+#include <sstream>
+
 namespace painting
 {
     Population::Population(const glm::vec2 &offset,
@@ -8,15 +11,20 @@ namespace painting
                            const glm::vec2 &scale_range,
                            const BrushAttributes::Probablity &probablity,
                            uint32_t min_population_size,
-                           uint32_t attributes_size)
-        : scale_range_(scale_range), probablity_(probablity)
+                           uint32_t attributes_size,
+                           uint32_t seed,
+                           uint32_t max_attributes_size)
+        : scale_range_(scale_range), probablity_(probablity), engine_(seed)
     {
         component_.offset = offset;
         component_.extent = extent;
 
         component_.min_population_size = min_population_size;
         component_.attributes_size = attributes_size;
+        component_.max_attributes_size = std::max(max_attributes_size, attributes_size);
         component_.stage_count = 0;
+        error_map_ = std::make_unique<ErrorMap>(offset, extent);
+        selection_ = std::make_unique<TruncationSelection>();
         push_back(component_.min_population_size);
     }
     Population::~Population()
@@ -28,8 +36,138 @@ namespace painting
         }
         population_.resize(0);
     }
+    void Population::set_target_colors(const TargetColors *target_colors)
+    {
+        target_colors_ = target_colors;
+        for (auto &attributes : population_)
+        {
+            attributes->set_target_colors(target_colors_);
+            int size = attributes->get_size();
+            for (int i = 0; i < size; i++)
+            {
+                attributes->set_seed_color(i, engine_);
+            }
+        }
+    }
+    void Population::set(int idx, std::unique_ptr<BrushAttributes> genome)
+    {
+        genome->set_error_map(error_map_.get());
+        genome->set_target_colors(target_colors_);
+        population_[idx] = std::move(genome);
+    }
+    void Population::replace_worst(std::unique_ptr<BrushAttributes> genome)
+    {
+        if (population_.empty())
+        {
+            return;
+        }
+        set(population_.size() - 1, std::move(genome));
+    }
+    void Population::begin_children(uint32_t first_child)
+    {
+        first_child_ = first_child;
+        parent_fitness_ = population_.empty() ? 0.0 : population_[0]->get_fitness();
+    }
+    void Population::adapt_steps(BrushAttributes &child)
+    {
+        if (step_adaptation_ == StepAdaptation::LOG_NORMAL)
+        {
+            child.adapt_steps(engine_);
+        }
+    }
+    void Population::write(ByteWriter &writer) const
+    {
+        writer.put(component_);
+        writer.put(best_fit_);
+        // text form of the mt19937 state is portable
+        std::ostringstream engine;
+        engine << engine_;
+        std::string state = engine.str();
+        writer.put<uint32_t>(state.size());
+        writer.put_bytes(state.data(), state.size());
+        error_map_->write(writer);
+        writer.put<uint32_t>(population_.size());
+        for (auto &attributes : population_)
+        {
+            attributes->write(writer);
+        }
+    }
+    void Population::read(ByteReader &reader)
+    {
+        PopulationComponent component = reader.get<PopulationComponent>();
+        if (component.offset != component_.offset || component.extent != component_.extent)
+        {
+            throw std::runtime_error("failed to read checkpoint! population strip");
+        }
+        component_ = component;
+        best_fit_ = reader.get<double>();
+        std::string state(reader.get<uint32_t>(), '\0');
+        reader.get_bytes(state.data(), state.size());
+        std::istringstream engine(state);
+        engine >> engine_;
+        if (engine.fail())
+        {
+            throw std::runtime_error("failed to read checkpoint! population engine");
+        }
+        error_map_->read(reader);
+        uint32_t size = reader.get<uint32_t>();
+        while (population_.size() < size)
+        {
+            push_back(1);
+        }
+        while (population_.size() > size)
+        {
+            pop_back();
+        }
+        for (auto &attributes : population_)
+        {
+            attributes->read(reader);
+        }
+        optimizer_state_.reset();
+    }
     void Population::sort()
     {
+        uint32_t size = population_.size();
+        if (component_.stage_count > 0 && first_child_ < size)
+        {
+            uint32_t success = 0;
+            for (uint32_t i = first_child_; i < size; i++)
+            {
+                if (population_[i]->get_fitness() > parent_fitness_)
+                {
+                    success++;
+                }
+            }
+            statistics_.success_rate = static_cast<double>(success) / (size - first_child_);
+            statistics_.running_success_rate = 0.9 * statistics_.running_success_rate + 0.1 * statistics_.success_rate;
+            if (step_adaptation_ == StepAdaptation::ONE_FIFTH && statistics_.success_rate != 0.2)
+            {
+                // rechenberg : c = 0.82
+                float factor = (statistics_.success_rate > 0.2) ? 1.22f : 0.82f;
+                for (auto &attributes : population_)
+                {
+                    attributes->scale_steps(factor);
+                }
+            }
+        }
+        MutationStep mean_step{0.0f, 0.0f, 0.0f, 0.0f};
+        for (auto &attributes : population_)
+        {
+            const MutationStep &steps = attributes->get_steps();
+            mean_step.translation += steps.translation;
+            mean_step.scale += steps.scale;
+            mean_step.rotation += steps.rotation;
+            mean_step.color += steps.color;
+        }
+        if (size > 0)
+        {
+            mean_step.translation /= size;
+            mean_step.scale /= size;
+            mean_step.rotation /= size;
+            mean_step.color /= size;
+        }
+        statistics_.mean_step = mean_step;
+
         std::sort(
             population_.begin(),
             population_.end(),
@@ -47,7 +185,11 @@ namespace painting
                 component_.extent,
                 scale_range_,
                 component_.attributes_size,
-                probablity_));
+                probablity_,
+                engine_,
+                component_.max_attributes_size));
+            population_.back()->set_error_map(error_map_.get());
+            population_.back()->set_target_colors(target_colors_);
         }
     }
     void Population::pop_back()
@@ -61,26 +203,37 @@ namespace painting
     }
     void Population::next_stage()
     {
-        int size = population_.size();
+        uint32_t size = population_.size();
         component_.stage_count++;
-        int half_size = size / 2;
-
-        for (int i = 0; i < half_size; i++)
+        if (size == 0)
         {
-            pop_back();
+            return;
         }
-        for (int i = 0; i < half_size; i++)
+        uint32_t survivor_count = selection_->get_survivor_count(size);
+        begin_children(survivor_count);
+
+        // every parent is selected from the current generation
+        offspring_.clear();
+        for (uint32_t i = survivor_count; i < size; i++)
         {
-            int parent1 = rand() % 3;
-            int parent2 = rand() % 3;
-            population_.push_back(population_[parent1]->cross_over(*population_[parent2]));
-            for (uint32_t j = 0; j < component_.attributes_size; j++)
+            uint32_t parent1 = selection_->select_parent(size, engine_);
+            uint32_t parent2 = selection_->select_parent(size, engine_);
+            offspring_.push_back(population_[parent1]->cross_over(*population_[parent2], engine_));
+            BrushAttributes *child = offspring_.back().get();
+            adapt_steps(*child);
+            child->mutate_structure(engine_);
+            int attributes_size = child->get_size();
+            for (int j = 0; j < attributes_size; j++)
             {
-                if (rand() % 2 == 0)
+                if (engine_() % 2 == 0)
                 {
-                    population_.back()->mutate(j);
+                    child->mutate(j, engine_);
                 }
             }
         }
+        for (uint32_t i = survivor_count; i < size; i++)
+        {
+            population_[i] = std::move(offspring_[i - survivor_count]);
+        }
     }
 } // namespace vkcpp
\ No newline at end of file
@@ -3,19 +3,46 @@
 
 #include "vulkan_header.h"
 #include "brush.h"
+#include "selection.h"
 #include <glm/glm.hpp>
 #include "vkcpp/stdafx.h"
 
 namespace painting
 {
+    class OptimizerState;
+
     struct PopulationComponent
     {
         glm::vec2 offset{};
         glm::vec2 extent{};
         uint32_t min_population_size{0};
         uint32_t attributes_size{0};
+        // stroke cap of a genome
+        uint32_t max_attributes_size{0};
         uint32_t stage_count{0};
     };
+    enum class StepAdaptation
+    {
+        NONE,
+        // per genome, inherited and perturbed with every child
+        LOG_NORMAL,
+        // per population, from the success rate of the children
+        ONE_FIFTH
+    };
+
+    /**
+     *  running statistics of the mutation steps (updated by sort)
+     */
+    struct MutationStatistics
+    {
+        // mean over the population
+        MutationStep mean_step{};
+        // children better than the best parent, last generation
+        double success_rate{0.0};
+        // exponential moving average of success_rate
+        double running_success_rate{0.0};
+    };
+
     /**
      * TODO: alpha sort
      */
@@ -27,6 +54,20 @@ namespace painting
         glm::vec2 scale_range_{};
         BrushAttributes::Probablity probablity_{};
         double best_fit_{0.0};
+        std::unique_ptr<ErrorMap> error_map_;
+        const TargetColors *target_colors_{nullptr};
+        std::unique_ptr<Selection> selection_;
+        // every random draw of this population (islands run on their own threads)
+        std::mt19937 engine_;
+        // owned by the Optimizer running this population (nullptr : stateless)
+        std::unique_ptr<OptimizerState> optimizer_state_;
+        StepAdaptation step_adaptation_{StepAdaptation::LOG_NORMAL};
+        MutationStatistics statistics_{};
+        // children of the current stage are [first_child_, size)
+        uint32_t first_child_{0};
+        double parent_fitness_{0.0};
+        // children of next_stage (capacity is reused)
+        std::vector<std::unique_ptr<BrushAttributes>> offspring_;
 
     public:
         Population(const glm::vec2 &offset,
@@ -34,7 +75,9 @@ namespace painting
                    const glm::vec2 &scale_range,
                    const BrushAttributes::Probablity &probablity,
                    uint32_t min_population_size,
-                   uint32_t attributes_size);
+                   uint32_t attributes_size,
+                   uint32_t seed,
+                   uint32_t max_attributes_size = 0);
 
         ~Population();
 
@@ -70,6 +113,26 @@ namespace painting
         {
             return population_.size();
         }
+        std::unique_ptr<OptimizerState> &get_mutable_optimizer_state()
+        {
+            return optimizer_state_;
+        }
+        std::mt19937 &get_mutable_engine()
+        {
+            return engine_;
+        }
+        ErrorMap &get_mutable_error_map()
+        {
+            return *error_map_;
+        }
+        const MutationStatistics &get_statistics() const
+        {
+            return statistics_;
+        }
+        void set_step_adaptation(StepAdaptation step_adaptation)
+        {
+            step_adaptation_ = step_adaptation;
+        }
         void set_best(double fit)
         {
             best_fit_ = fit;
@@ -79,9 +142,58 @@ namespace painting
             return best_fit_;
         }
 
+        /**
+         *  @brief new strokes (and the strokes of the current genomes) are seeded from the target
+         */
+        void set_target_colors(const TargetColors *target_colors);
+
+        /**
+         *  @brief default : TruncationSelection (best half survives, parents from the best 3)
+         */
+        void set_selection(std::unique_ptr<Selection> selection)
+        {
+            selection_ = std::move(selection);
+        }
+
+        /**
+         *  @brief replace the genome of idx (bound to the error map and target colors of this population)
+         */
+        void set(int idx, std::unique_ptr<BrushAttributes> genome);
+
+        /**
+         *  @brief the last genome is replaced (migration)
+         */
+        void replace_worst(std::unique_ptr<BrushAttributes> genome);
+
+        /**
+         *  @brief children of this stage are [first_child, size), compared with the current best (sorted) in sort
+         */
+        void begin_children(uint32_t first_child);
+
+        /**
+         *  @brief LOG_NORMAL : perturb the steps of a new child
+         */
+        void adapt_steps(BrushAttributes &child);
+
+        /**
+         *  @brief best first, then the mutation statistics (and ONE_FIFTH steps) are updated
+         */
         void sort();
+
+        /**
+         *  @brief component, best fitness, engine state, error map and genomes
+         */
+        void write(ByteWriter &writer) const;
+
+        /**
+         *  @brief the population is resized to the checkpoint, optimizer state restarts
+         */
+        void read(ByteReader &reader);
         void push_back(int count);
         void pop_back();
+        /**
+         *  @brief replace the non survivors with children of selected parents (population must be sorted)
+         */
         void next_stage();
     };
 }
@@ -0,0 +1,185 @@
+#include "remote_protocol.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <csignal>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace painting
+{
+    // ~1 GB : a larger size is a broken stream
+    static const uint32_t MAX_PAYLOAD_SIZE = 1u << 30;
+
+    static void initSockets()
+    {
+#ifdef _WIN32
+        static bool is_initialized = false;
+        if (!is_initialized)
+        {
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+            is_initialized = true;
+        }
+#else
+        // a closed peer is a failed send, not SIGPIPE
+        signal(SIGPIPE, SIG_IGN);
+#endif
+    }
+
+    Connection::~Connection()
+    {
+        closeSocket(fd_);
+    }
+
+    void Connection::closeSocket(int fd)
+    {
+        if (fd < 0)
+        {
+            return;
+        }
+#ifdef _WIN32
+        closesocket(fd);
+#else
+        close(fd);
+#endif
+    }
+
+    std::unique_ptr<Connection> Connection::connectTo(const std::string &address)
+    {
+        size_t colon = address.find_last_of(':');
+        if (colon == std::string::npos)
+        {
+            throw std::runtime_error("expected host:port, got " + address);
+        }
+        std::string host = address.substr(0, colon);
+        std::string port = address.substr(colon + 1);
+        initSockets();
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *result = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0)
+        {
+            throw std::runtime_error("failed to resolve worker: " + address);
+        }
+        int fd = -1;
+        for (addrinfo *info = result; info != nullptr; info = info->ai_next)
+        {
+            fd = static_cast<int>(socket(info->ai_family, info->ai_socktype, info->ai_protocol));
+            if (fd < 0)
+            {
+                continue;
+            }
+            if (connect(fd, info->ai_addr, static_cast<int>(info->ai_addrlen)) == 0)
+            {
+                break;
+            }
+            closeSocket(fd);
+            fd = -1;
+        }
+        freeaddrinfo(result);
+        if (fd < 0)
+        {
+            throw std::runtime_error("failed to connect to worker: " + address);
+        }
+        // small request/reply messages : no nagle delay
+        int flag = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&flag), sizeof(flag));
+        return std::make_unique<Connection>(fd);
+    }
+
+    int Connection::listenOn(uint16_t port)
+    {
+        initSockets();
+        int fd = static_cast<int>(socket(AF_INET, SOCK_STREAM, 0));
+        if (fd < 0)
+        {
+            throw std::runtime_error("failed to create worker socket!");
+        }
+        int flag = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&flag), sizeof(flag));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+        if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(fd, 4) != 0)
+        {
+            closeSocket(fd);
+            throw std::runtime_error("failed to listen on port " + std::to_string(port));
+        }
+        return fd;
+    }
+
+    std::unique_ptr<Connection> Connection::acceptFrom(int listen_fd)
+    {
+        int fd = static_cast<int>(accept(listen_fd, nullptr, nullptr));
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+        int flag = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&flag), sizeof(flag));
+        return std::make_unique<Connection>(fd);
+    }
+
+    void Connection::send_all(const char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            auto sent = ::send(fd_, data, static_cast<int>(size), 0);
+            if (sent <= 0)
+            {
+                throw std::runtime_error("connection closed while sending!");
+            }
+            data += sent;
+            size -= static_cast<size_t>(sent);
+        }
+    }
+
+    void Connection::receive_all(char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            auto received = ::recv(fd_, data, static_cast<int>(size), 0);
+            if (received <= 0)
+            {
+                throw std::runtime_error("connection closed while receiving!");
+            }
+            data += received;
+            size -= static_cast<size_t>(received);
+        }
+    }
+
+    void Connection::send(MessageType type, const std::vector<char> &payload)
+    {
+        char header[5];
+        uint32_t size = static_cast<uint32_t>(payload.size());
+        memcpy(header, &size, sizeof(size));
+        header[4] = static_cast<char>(type);
+        send_all(header, sizeof(header));
+        send_all(payload.data(), payload.size());
+    }
+
+    MessageType Connection::receive(std::vector<char> &payload)
+    {
+        char header[5];
+        receive_all(header, sizeof(header));
+        uint32_t size;
+        memcpy(&size, header, sizeof(size));
+        if (size > MAX_PAYLOAD_SIZE)
+        {
+            throw std::runtime_error("invalid message size!");
+        }
+        payload.resize(size);
+        receive_all(payload.data(), size);
+        return static_cast<MessageType>(header[4]);
+    }
+} // namespace painting
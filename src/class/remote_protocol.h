@@ -0,0 +1,76 @@
+#ifndef CLASS_REMOTE_PROTOCOL_H
+#define CLASS_REMOTE_PROTOCOL_H
+
+#include "checkpoint.h"
+
+namespace painting
+{
+    /**
+     *  coordinator -> worker : HELLO, CANVAS, EVALUATE, RENDER, BYE
+     *  worker -> coordinator : READY, FITNESS, ROWS
+     *
+     *  HELLO    magic, version, extent, population and stroke sizes, strip count, target and canvas pixels
+     *  READY    brush half extents
+     *  CANVAS   y, height, rows of the accepted strip (canvas delta)
+     *  EVALUATE strip, count, genomes           -> FITNESS count, fitness values
+     *  RENDER   strip, genome                   -> ROWS fitness, y, height, rows
+     */
+    enum class MessageType : uint8_t
+    {
+        HELLO = 1,
+        READY,
+        CANVAS,
+        EVALUATE,
+        FITNESS,
+        RENDER,
+        ROWS,
+        BYE
+    };
+
+    /**
+     *  Framed binary messages over a tcp stream : payload size (uint32), type (uint8), payload.
+     *  Payloads are ByteWriter bytes (host byte order) : coordinator and workers share the byte order.
+     */
+    class Connection
+    {
+    private:
+        int fd_{-1};
+
+        void send_all(const char *data, size_t size);
+
+        void receive_all(char *data, size_t size);
+
+    public:
+        static const uint32_t MAGIC_ = 0x57504b56; // "VKPW"
+        static const uint32_t VERSION_ = 1;
+
+        explicit Connection(int fd) : fd_(fd) {}
+
+        Connection(const Connection &) = delete;
+
+        ~Connection();
+
+        /**
+         *  @param address host:port
+         */
+        static std::unique_ptr<Connection> connectTo(const std::string &address);
+
+        /**
+         *  @return listening socket of the port (all interfaces)
+         */
+        static int listenOn(uint16_t port);
+
+        /**
+         *  @return nullptr if the listening socket is closed
+         */
+        static std::unique_ptr<Connection> acceptFrom(int listen_fd);
+
+        static void closeSocket(int fd);
+
+        void send(MessageType type, const std::vector<char> &payload);
+
+        MessageType receive(std::vector<char> &payload);
+    }; // class Connection
+} // namespace painting
+
+#endif // #ifndef CLASS_REMOTE_PROTOCOL_H
@@ -0,0 +1,171 @@
+#include "remote_worker.h"
+
+#include "device/physical_device.h"
+#include "utility/trace.h"
+
+namespace painting
+{
+    RemoteWorker::RemoteWorker(uint16_t port)
+        : port_(port)
+    {
+        instance_ = std::make_unique<vkcpp::Instance>(true);
+        instance_->query_gpus(nullptr);
+        std::vector<const char *> device_extensions;
+        vkcpp::PhysicalDevice *gpu = instance_->get_suitable_gpu(device_extensions);
+        device_ = std::make_unique<vkcpp::Device>(gpu);
+        command_pool_ = std::make_unique<vkcpp::CommandPool>(device_.get(), device_->get_graphics_queue(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    }
+
+    RemoteWorker::~RemoteWorker()
+    {
+        stop();
+        if (device_)
+        {
+            vkDeviceWaitIdle(*device_);
+        }
+        command_pool_.reset();
+        device_.reset();
+        instance_.reset();
+    }
+
+    void RemoteWorker::run()
+    {
+        listen_fd_ = Connection::listenOn(port_);
+        std::cout << "worker listening on port " << port_ << "\n";
+        while (true)
+        {
+            std::unique_ptr<Connection> connection = Connection::acceptFrom(listen_fd_);
+            if (!connection)
+            {
+                break;
+            }
+            try
+            {
+                serve(*connection);
+            }
+            catch (const std::exception &e)
+            {
+                // the coordinator is gone or sent a broken message : wait for the next one
+                std::cerr << "worker: " << e.what() << "\n";
+            }
+        }
+    }
+
+    void RemoteWorker::stop()
+    {
+        Connection::closeSocket(listen_fd_);
+        listen_fd_ = -1;
+    }
+
+    void RemoteWorker::serve(Connection &connection)
+    {
+        VKCPP_TRACE_SCOPE("RemoteWorker::serve");
+        std::unique_ptr<Picture> picture;
+        std::vector<char> target;
+        std::vector<char> canvas;
+        std::vector<char> payload;
+        std::vector<char> rows;
+        VkExtent3D extent{};
+        while (true)
+        {
+            MessageType type = connection.receive(payload);
+            ByteReader reader(payload);
+            if (type == MessageType::BYE)
+            {
+                break;
+            }
+            if (type != MessageType::HELLO && !picture)
+            {
+                throw std::runtime_error("expected HELLO before the first job message!");
+            }
+            ByteWriter writer;
+            switch (type)
+            {
+            case MessageType::HELLO:
+            {
+                if (reader.get<uint32_t>() != Connection::MAGIC_ || reader.get<uint32_t>() != Connection::VERSION_)
+                {
+                    throw std::runtime_error("coordinator protocol mismatch!");
+                }
+                BatchJob job;
+                extent = {reader.get<uint32_t>(), reader.get<uint32_t>(), 1};
+                job.population_size = reader.get<uint32_t>();
+                job.brush_count = reader.get<uint32_t>();
+                job.strip_count = reader.get<uint32_t>();
+                size_t image_size = static_cast<size_t>(extent.width) * extent.height * 4;
+                target.resize(image_size);
+                canvas.resize(image_size);
+                reader.get_bytes(target.data(), image_size);
+                reader.get_bytes(canvas.data(), image_size);
+
+                // the previous session is done : its submissions are completed
+                picture.reset();
+                picture = BatchRunner::createPicture(device_.get(), command_pool_.get(), job, extent);
+                picture->sub_texture_pixels(canvas.data(), image_size);
+
+                std::vector<glm::vec2> half_extents = picture->get_mutable_brushes().get_region_half_extents();
+                writer.put(static_cast<uint32_t>(half_extents.size()));
+                for (auto &half_extent : half_extents)
+                {
+                    writer.put(half_extent);
+                }
+                connection.send(MessageType::READY, writer.get_mutable_bytes());
+                break;
+            }
+            case MessageType::CANVAS:
+            {
+                uint32_t y = reader.get<uint32_t>();
+                uint32_t height = reader.get<uint32_t>();
+                size_t row_size = static_cast<size_t>(extent.width) * 4;
+                if (y + height > extent.height)
+                {
+                    throw std::runtime_error("canvas rows out of the picture!");
+                }
+                reader.get_bytes(canvas.data() + y * row_size, height * row_size);
+                picture->sub_texture_pixels(canvas.data(), canvas.size());
+                break;
+            }
+            case MessageType::EVALUATE:
+            {
+                uint32_t strip = reader.get<uint32_t>();
+                uint32_t count = reader.get<uint32_t>();
+                if (strip >= picture->get_strip_count())
+                {
+                    throw std::runtime_error("strip out of the picture!");
+                }
+                writer.put(count);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    picture->get_mutable_genome(strip).read(reader);
+                    writer.put(picture->evaluate(strip, target.data()));
+                }
+                connection.send(MessageType::FITNESS, writer.get_mutable_bytes());
+                break;
+            }
+            case MessageType::RENDER:
+            {
+                uint32_t strip = reader.get<uint32_t>();
+                if (strip >= picture->get_strip_count())
+                {
+                    throw std::runtime_error("strip out of the picture!");
+                }
+                picture->get_mutable_genome(strip).read(reader);
+                VkRect2D area{};
+                double fitness = picture->evaluate(strip, target.data(), &rows, &area);
+                writer.put(fitness);
+                writer.put(static_cast<uint32_t>(area.offset.y));
+                writer.put(area.extent.height);
+                writer.put_bytes(rows.data(), rows.size());
+                connection.send(MessageType::ROWS, writer.get_mutable_bytes());
+                break;
+            }
+            default:
+                throw std::runtime_error("unexpected message from the coordinator!");
+            }
+        }
+        if (picture)
+        {
+            vkDeviceWaitIdle(*device_);
+        }
+    }
+} // namespace painting
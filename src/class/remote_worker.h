@@ -0,0 +1,50 @@
+#ifndef CLASS_REMOTE_WORKER_H
+#define CLASS_REMOTE_WORKER_H
+
+#include "batch_runner.h"
+#include "remote_protocol.h"
+
+namespace painting
+{
+    /**
+     *  Evaluation worker of a Coordinator (headless) : renders and scores the genomes it receives
+     *  on its own device, the coordinator owns the populations and the optimizer.
+     *
+     *  One coordinator at a time : HELLO creates the Picture (target, canvas), CANVAS applies accepted rows,
+     *  EVALUATE returns the fitness of every genome, RENDER returns the rows of the accepted genome.
+     */
+    class RemoteWorker
+    {
+    private:
+        std::unique_ptr<vkcpp::Instance> instance_;
+
+        std::unique_ptr<vkcpp::Device> device_;
+
+        std::unique_ptr<vkcpp::CommandPool> command_pool_;
+
+        uint16_t port_{0};
+
+        int listen_fd_{-1};
+
+        /**
+         *  @brief messages of a coordinator until BYE
+         */
+        void serve(Connection &connection);
+
+    public:
+        explicit RemoteWorker(uint16_t port);
+
+        RemoteWorker(const RemoteWorker &) = delete;
+
+        ~RemoteWorker();
+
+        /**
+         *  @brief serve coordinators one after another until stop
+         */
+        void run();
+
+        void stop();
+    }; // class RemoteWorker
+} // namespace painting
+
+#endif // #ifndef CLASS_REMOTE_WORKER_H
@@ -0,0 +1,85 @@
+#include "selection.h"
+#include "utility/utility.h"
+
+#include <cmath>
+
+namespace painting
+{
+    TruncationSelection::TruncationSelection(uint32_t elite_count, uint32_t parent_pool)
+        : Selection(elite_count), parent_pool_(std::max(parent_pool, 1u))
+    {
+    }
+    uint32_t TruncationSelection::get_survivor_count(uint32_t size) const
+    {
+        return std::min(size, std::max(size - size / 2, elite_count_));
+    }
+    uint32_t TruncationSelection::select_parent(uint32_t size, std::mt19937 &engine) const
+    {
+        return engine() % std::min(parent_pool_, size);
+    }
+
+    TournamentSelection::TournamentSelection(uint32_t elite_count, uint32_t tournament_size)
+        : Selection(elite_count), tournament_size_(std::max(tournament_size, 1u))
+    {
+    }
+    uint32_t TournamentSelection::get_survivor_count(uint32_t size) const
+    {
+        return std::min(size, elite_count_);
+    }
+    uint32_t TournamentSelection::select_parent(uint32_t size, std::mt19937 &engine) const
+    {
+        // sorted : the best of the picks is the lowest rank
+        uint32_t best = engine() % size;
+        for (uint32_t i = 1; i < tournament_size_; i++)
+        {
+            best = std::min(best, static_cast<uint32_t>(engine() % size));
+        }
+        return best;
+    }
+
+    RankSelection::RankSelection(uint32_t elite_count)
+        : Selection(elite_count)
+    {
+    }
+    uint32_t RankSelection::get_survivor_count(uint32_t size) const
+    {
+        return std::min(size, elite_count_);
+    }
+    uint32_t RankSelection::select_parent(uint32_t size, std::mt19937 &engine) const
+    {
+        // weight of rank r is (n - r), inverse of the cumulative weight in closed form
+        double n = static_cast<double>(size);
+        double total = n * (n + 1.0) / 2.0;
+        double u = static_cast<double>(vkcpp::getProbablity(engine)) * total;
+        // cumulative(r) = (r + 1) * n - r * (r + 1) / 2 >= u
+        double b = 2.0 * n + 1.0;
+        double r = std::ceil((b - std::sqrt(std::max(b * b - 8.0 * u, 0.0))) / 2.0) - 1.0;
+        return std::min(static_cast<uint32_t>(std::max(r, 0.0)), size - 1);
+    }
+
+    MuPlusLambdaSelection::MuPlusLambdaSelection(uint32_t mu, uint32_t elite_count)
+        : Selection(elite_count), mu_(std::max(mu, 1u))
+    {
+    }
+    uint32_t MuPlusLambdaSelection::get_survivor_count(uint32_t size) const
+    {
+        return std::min(size, std::max(mu_, elite_count_));
+    }
+    uint32_t MuPlusLambdaSelection::select_parent(uint32_t size, std::mt19937 &engine) const
+    {
+        return engine() % std::min(mu_, size);
+    }
+
+    MuCommaLambdaSelection::MuCommaLambdaSelection(uint32_t mu, uint32_t elite_count)
+        : Selection(elite_count), mu_(std::max(mu, 1u))
+    {
+    }
+    uint32_t MuCommaLambdaSelection::get_survivor_count(uint32_t size) const
+    {
+        return std::min(size, elite_count_);
+    }
+    uint32_t MuCommaLambdaSelection::select_parent(uint32_t size, std::mt19937 &engine) const
+    {
+        return engine() % std::min(mu_, size);
+    }
+} // namespace painting
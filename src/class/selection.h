@@ -0,0 +1,118 @@
+#ifndef CLASS_SELECTION_H
+#define CLASS_SELECTION_H
+
+#include "vkcpp/stdafx.h"
+
+#include <random>
+
+namespace painting
+{
+    /**
+     *  Selection and replacement of Population::next_stage.
+     *  The population is sorted by fitness (best first), so strategies work on ranks only:
+     *  O(1) or O(k) per parent, no allocation.
+     */
+    class Selection
+    {
+    protected:
+        // best genomes always kept
+        uint32_t elite_count_{1};
+
+    public:
+        explicit Selection(uint32_t elite_count) : elite_count_(elite_count) {}
+
+        virtual ~Selection() = default;
+
+        const uint32_t get_elite_count() const { return elite_count_; }
+
+        /**
+         *  @return genomes kept (ranks [0, count)), the rest is replaced by children
+         */
+        virtual uint32_t get_survivor_count(uint32_t size) const = 0;
+
+        /**
+         *  @param engine of the population
+         *  @return rank of a parent, parents are chosen before any replacement
+         */
+        virtual uint32_t select_parent(uint32_t size, std::mt19937 &engine) const = 0;
+    }; // class Selection
+
+    /**
+     *  keeps the best half, parents are uniform among the best parent_pool
+     */
+    class TruncationSelection : public Selection
+    {
+    private:
+        uint32_t parent_pool_{3};
+
+    public:
+        TruncationSelection(uint32_t elite_count = 1, uint32_t parent_pool = 3);
+
+        uint32_t get_survivor_count(uint32_t size) const override;
+
+        uint32_t select_parent(uint32_t size, std::mt19937 &engine) const override;
+    }; // class TruncationSelection
+
+    /**
+     *  keeps the elite, parent : best of k uniform picks
+     */
+    class TournamentSelection : public Selection
+    {
+    private:
+        uint32_t tournament_size_{2};
+
+    public:
+        TournamentSelection(uint32_t elite_count = 1, uint32_t tournament_size = 2);
+
+        uint32_t get_survivor_count(uint32_t size) const override;
+
+        uint32_t select_parent(uint32_t size, std::mt19937 &engine) const override;
+    }; // class TournamentSelection
+
+    /**
+     *  keeps the elite, parent : roulette over linear rank weights (n - rank)
+     */
+    class RankSelection : public Selection
+    {
+    public:
+        explicit RankSelection(uint32_t elite_count = 1);
+
+        uint32_t get_survivor_count(uint32_t size) const override;
+
+        uint32_t select_parent(uint32_t size, std::mt19937 &engine) const override;
+    }; // class RankSelection
+
+    /**
+     *  (mu + lambda) : the best mu are kept and are the parents of the lambda = size - mu children
+     */
+    class MuPlusLambdaSelection : public Selection
+    {
+    private:
+        uint32_t mu_{1};
+
+    public:
+        MuPlusLambdaSelection(uint32_t mu, uint32_t elite_count = 1);
+
+        uint32_t get_survivor_count(uint32_t size) const override;
+
+        uint32_t select_parent(uint32_t size, std::mt19937 &engine) const override;
+    }; // class MuPlusLambdaSelection
+
+    /**
+     *  (mu, lambda) : the best mu are the parents, only the elite survives
+     */
+    class MuCommaLambdaSelection : public Selection
+    {
+    private:
+        uint32_t mu_{1};
+
+    public:
+        MuCommaLambdaSelection(uint32_t mu, uint32_t elite_count = 0);
+
+        uint32_t get_survivor_count(uint32_t size) const override;
+
+        uint32_t select_parent(uint32_t size, std::mt19937 &engine) const override;
+    }; // class MuCommaLambdaSelection
+} // namespace painting
+
+#endif // #ifndef CLASS_SELECTION_H
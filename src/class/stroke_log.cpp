@@ -0,0 +1,158 @@
+#include "stroke_log.h"
+
+#include <cmath>
+#include <map>
+
+namespace painting
+{
+    static float linearToSrgb(float c)
+    {
+        c = std::clamp(c, 0.0f, 1.0f);
+        return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    }
+
+    void StrokeLog::append(uint64_t run, uint32_t strip, const VkRect2D &area, const BrushAttributes &winner)
+    {
+        StrokeRecord record;
+        record.run = run;
+        record.strip = strip;
+        record.area = area;
+        record.fitness = winner.get_fitness();
+        int size = winner.get_size();
+        for (int i = 0; i < size; i++)
+        {
+            record.strokes.push_back(winner.get_attribute(i));
+        }
+        stroke_count_ += record.strokes.size();
+        records_.push_back(std::move(record));
+    }
+
+    void StrokeLog::export_json(const std::string &filename, const VkExtent3D &extent) const
+    {
+        std::ofstream file(filename, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("failed to open stroke log file!");
+        }
+        // {"width":w,"height":h,"records":[{"run":0,"strip":0,"area":[x,y,w,h],"fitness":0.9,"strokes":[{...}]}]}
+        file << "{\"width\":" << extent.width << ",\"height\":" << extent.height << ",\"records\":[";
+        for (size_t i = 0; i < records_.size(); i++)
+        {
+            const StrokeRecord &record = records_[i];
+            file << (i == 0 ? "" : ",") << "\n{\"run\":" << record.run << ",\"strip\":" << record.strip
+                 << ",\"area\":[" << record.area.offset.x << "," << record.area.offset.y << "," << record.area.extent.width << "," << record.area.extent.height << "]"
+                 << ",\"fitness\":" << record.fitness << ",\"strokes\":[";
+            for (size_t j = 0; j < record.strokes.size(); j++)
+            {
+                const BrushAttributeComponent &stroke = record.strokes[j];
+                file << (j == 0 ? "" : ",")
+                     << "{\"brush\":" << stroke.object_idx
+                     << ",\"translation\":[" << stroke.translation.x << "," << stroke.translation.y << "]"
+                     << ",\"scale\":[" << stroke.scale.x << "," << stroke.scale.y << "]"
+                     << ",\"rotation\":" << stroke.rotation_z
+                     << ",\"color\":[" << stroke.color.r << "," << stroke.color.g << "," << stroke.color.b << "," << stroke.color.a << "]}";
+            }
+            file << "]}";
+        }
+        file << "\n]}\n";
+    }
+
+    void StrokeLog::export_svg(const std::string &filename,
+                               const VkExtent3D &extent,
+                               const std::vector<const char *> &texture_files,
+                               const std::vector<glm::vec2> &half_extents) const
+    {
+        std::ofstream file(filename, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("failed to open stroke svg file!");
+        }
+        file << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\""
+             << " width=\"" << extent.width << "\" height=\"" << extent.height
+             << "\" viewBox=\"0 0 " << extent.width << " " << extent.height << "\">\n<defs>\n";
+        size_t brush_count = std::min(texture_files.size(), half_extents.size());
+        for (size_t i = 0; i < brush_count; i++)
+        {
+            const glm::vec2 &h = half_extents[i];
+            file << "<mask id=\"brush" << i << "\" style=\"mask-type:alpha\" maskContentUnits=\"userSpaceOnUse\">"
+                 << "<image xlink:href=\"" << texture_files[i] << "\" x=\"" << -h.x << "\" y=\"" << -h.y
+                 << "\" width=\"" << 2.0f * h.x << "\" height=\"" << 2.0f * h.y << "\"/></mask>\n";
+        }
+        // one clip per strip : a strip only paints its own rows
+        std::map<uint32_t, VkRect2D> strip_areas;
+        for (const StrokeRecord &record : records_)
+        {
+            strip_areas.emplace(record.strip, record.area);
+        }
+        for (auto &[strip, area] : strip_areas)
+        {
+            file << "<clipPath id=\"strip" << strip << "\"><rect x=\"" << area.offset.x << "\" y=\"" << area.offset.y
+                 << "\" width=\"" << area.extent.width << "\" height=\"" << area.extent.height << "\"/></clipPath>\n";
+        }
+        file << "</defs>\n<rect width=\"100%\" height=\"100%\" fill=\"#ffffff\"/>\n";
+        if (brush_count == 0)
+        {
+            file << "</svg>\n";
+            return;
+        }
+
+        for (const StrokeRecord &record : records_)
+        {
+            file << "<g clip-path=\"url(#strip" << record.strip << ")\">\n";
+            for (const BrushAttributeComponent &stroke : record.strokes)
+            {
+                size_t brush = stroke.object_idx % brush_count;
+                const glm::vec2 &h = half_extents[brush];
+                file << "<rect x=\"" << -h.x << "\" y=\"" << -h.y << "\" width=\"" << 2.0f * h.x << "\" height=\"" << 2.0f * h.y << "\""
+                     << " transform=\"translate(" << stroke.translation.x << " " << stroke.translation.y << ")"
+                     << " rotate(" << glm::degrees(stroke.rotation_z) << ")"
+                     << " scale(" << stroke.scale.x << " " << stroke.scale.y << ")\""
+                     << " fill=\"rgb(" << static_cast<int>(std::round(linearToSrgb(stroke.color.r) * 255.0f)) << ","
+                     << static_cast<int>(std::round(linearToSrgb(stroke.color.g) * 255.0f)) << ","
+                     << static_cast<int>(std::round(linearToSrgb(stroke.color.b) * 255.0f)) << ")\""
+                     << " fill-opacity=\"" << stroke.color.a << "\" mask=\"url(#brush" << brush << ")\"/>\n";
+            }
+            file << "</g>\n";
+        }
+        file << "</svg>\n";
+    }
+
+    void StrokeLog::write(ByteWriter &writer) const
+    {
+        writer.put<uint64_t>(records_.size());
+        for (const StrokeRecord &record : records_)
+        {
+            writer.put(record.run);
+            writer.put(record.strip);
+            writer.put(record.area);
+            writer.put(record.fitness);
+            writer.put<uint32_t>(record.strokes.size());
+            for (const BrushAttributeComponent &stroke : record.strokes)
+            {
+                BrushAttributes::writeStroke(writer, stroke);
+            }
+        }
+    }
+
+    void StrokeLog::read(ByteReader &reader)
+    {
+        records_.clear();
+        stroke_count_ = 0;
+        uint64_t size = reader.get<uint64_t>();
+        for (uint64_t i = 0; i < size; i++)
+        {
+            StrokeRecord record;
+            record.run = reader.get<uint64_t>();
+            record.strip = reader.get<uint32_t>();
+            record.area = reader.get<VkRect2D>();
+            record.fitness = reader.get<double>();
+            uint32_t stroke_size = reader.get<uint32_t>();
+            for (uint32_t j = 0; j < stroke_size; j++)
+            {
+                record.strokes.push_back(BrushAttributes::readStroke(reader));
+            }
+            stroke_count_ += record.strokes.size();
+            records_.push_back(std::move(record));
+        }
+    }
+} // namespace painting
@@ -0,0 +1,57 @@
+#ifndef CLASS_STROKE_LOG_H
+#define CLASS_STROKE_LOG_H
+
+#include "brush.h"
+#include "checkpoint.h"
+
+namespace painting
+{
+    /**
+     *  strokes of an accepted generation, painted over the canvas in order
+     */
+    struct StrokeRecord
+    {
+        uint64_t run{0};
+        uint32_t strip{0};
+        // pixels the strip may paint : strokes are clipped to it
+        VkRect2D area{};
+        double fitness{0.0};
+        std::vector<BrushAttributeComponent> strokes;
+    }; // struct StrokeRecord
+
+    /**
+     *  Every accepted winner in order : replaying the records over a white canvas gives the painting.
+     *  Coordinates are pixels of the picture extent.
+     */
+    class StrokeLog
+    {
+    private:
+        std::vector<StrokeRecord> records_;
+
+        size_t stroke_count_{0};
+
+    public:
+        void append(uint64_t run, uint32_t strip, const VkRect2D &area, const BrushAttributes &winner);
+
+        const std::vector<StrokeRecord> &get_records() const { return records_; }
+
+        const size_t get_stroke_count() const { return stroke_count_; }
+
+        void export_json(const std::string &filename, const VkExtent3D &extent) const;
+
+        /**
+         *  @brief one masked rect per stroke (brush texture alpha as mask, color converted to srgb), clipped to its strip
+         *  @param texture_files, half_extents : brush textures and their half sizes, indexed by object_idx
+         */
+        void export_svg(const std::string &filename,
+                        const VkExtent3D &extent,
+                        const std::vector<const char *> &texture_files,
+                        const std::vector<glm::vec2> &half_extents) const;
+
+        void write(ByteWriter &writer) const;
+
+        void read(ByteReader &reader);
+    }; // class StrokeLog
+} // namespace painting
+
+#endif // #ifndef CLASS_STROKE_LOG_H
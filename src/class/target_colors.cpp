@@ -0,0 +1,60 @@
+#include "target_colors.h"
+
+namespace painting
+{
+    static float srgbToLinear(float c)
+    {
+        return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    TargetColors::TargetColors(const char *data, uint32_t width, uint32_t height, const std::vector<glm::vec2> &half_extents)
+        : width_(width), height_(height), half_extents_(half_extents)
+    {
+        const unsigned char *ua = (const unsigned char *)data;
+        uint32_t stride = width_ + 1;
+        table_.assign(stride * (height_ + 1), glm::u64vec3(0));
+
+        for (uint32_t i = 0; i < height_; i++)
+        {
+            glm::u64vec3 row(0);
+            for (uint32_t j = 0; j < width_; j++)
+            {
+                const unsigned char *pixel = ua + (i * width_ + j) * 4;
+                row += glm::u64vec3(pixel[0], pixel[1], pixel[2]);
+                table_[(i + 1) * stride + j + 1] = table_[i * stride + j + 1] + row;
+            }
+        }
+    }
+
+    glm::vec3 TargetColors::get_mean(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const
+    {
+        x0 = std::clamp(x0, 0, static_cast<int32_t>(width_));
+        x1 = std::clamp(x1, 0, static_cast<int32_t>(width_));
+        y0 = std::clamp(y0, 0, static_cast<int32_t>(height_));
+        y1 = std::clamp(y1, 0, static_cast<int32_t>(height_));
+        if (x1 <= x0 || y1 <= y0)
+        {
+            return glm::vec3(0.0f);
+        }
+        uint32_t stride = width_ + 1;
+        glm::u64vec3 sum = table_[y1 * stride + x1] + table_[y0 * stride + x0] - table_[y0 * stride + x1] - table_[y1 * stride + x0];
+        float count = static_cast<float>((x1 - x0) * (y1 - y0));
+        return glm::vec3(sum) / (count * 255.0f);
+    }
+
+    glm::vec3 TargetColors::get_footprint_color(const glm::vec2 &center, const glm::vec2 &scale, float rotation, int object_idx) const
+    {
+        glm::vec2 half_extent = half_extents_.empty() ? glm::vec2(0.5f) : half_extents_[object_idx % half_extents_.size()] * scale;
+        float c = std::abs(std::cos(rotation));
+        float s = std::abs(std::sin(rotation));
+        // at least one pixel
+        glm::vec2 box = glm::max(glm::vec2(c * half_extent.x + s * half_extent.y, s * half_extent.x + c * half_extent.y), glm::vec2(0.5f));
+
+        glm::vec3 mean = get_mean(static_cast<int32_t>(std::floor(center.x - box.x)),
+                                  static_cast<int32_t>(std::floor(center.y - box.y)),
+                                  static_cast<int32_t>(std::ceil(center.x + box.x)),
+                                  static_cast<int32_t>(std::ceil(center.y + box.y)));
+        // the offscreen is srgb : shader output is linear
+        return glm::vec3(srgbToLinear(mean.r), srgbToLinear(mean.g), srgbToLinear(mean.b));
+    }
+} // namespace painting
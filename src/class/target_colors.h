@@ -0,0 +1,45 @@
+#ifndef CLASS_TARGET_COLORS_H
+#define CLASS_TARGET_COLORS_H
+
+#include <glm/glm.hpp>
+#include "vkcpp/stdafx.h"
+
+namespace painting
+{
+    /**
+     *  Summed-area table of the target image (r, g, b),
+     *  the mean color under any axis-aligned rectangle is O(1).
+     *  Used to seed the color of new strokes.
+     */
+    class TargetColors
+    {
+    private:
+        uint32_t width_{0};
+        uint32_t height_{0};
+
+        // (width + 1) * (height + 1) prefix sums per channel, first row and column are 0
+        std::vector<glm::u64vec3> table_;
+
+        // half size in pixels of each brush (scale 1)
+        std::vector<glm::vec2> half_extents_;
+
+    public:
+        /**
+         *  @param data tightly packed r8g8b8a8 (srgb) target
+         *  @param half_extents indexed by BrushAttributeComponent::object_idx
+         */
+        TargetColors(const char *data, uint32_t width, uint32_t height, const std::vector<glm::vec2> &half_extents);
+
+        /**
+         *  @return mean of [x0, x1) x [y0, y1) clamped to the image, normalized srgb
+         */
+        glm::vec3 get_mean(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const;
+
+        /**
+         *  @return linear mean color under the bounding box of the transformed brush quad
+         */
+        glm::vec3 get_footprint_color(const glm::vec2 &center, const glm::vec2 &scale, float rotation, int object_idx) const;
+    }; // class TargetColors
+} // namespace painting
+
+#endif // #ifndef CLASS_TARGET_COLORS_H
@@ -1,14 +1,122 @@
 #include "class/application.h"
+#include "class/batch_runner.h"
+#include "class/coordinator.h"
+#include "class/job_server.h"
+#include "class/multi_device_painter.h"
+#include "class/remote_worker.h"
 #include <cstdlib>
 #include <ctime>
+#include <sstream>
 
-int main()
+int main(int argc, char **argv)
 {
     srand(static_cast<unsigned int>(time(NULL)));
-    painting::PaintingApplication app;
 
     try
     {
+        // painting --batch manifest.txt [workers] : headless, no window
+        if (argc >= 3 && std::string(argv[1]) == "--batch")
+        {
+            uint32_t workers = (argc >= 4) ? static_cast<uint32_t>(std::atoi(argv[3])) : 2u;
+            painting::BatchRunner runner(argv[2], workers);
+            runner.run("batch_metrics.jsonl");
+            return EXIT_SUCCESS;
+        }
+        // painting --serve socket_path [max_jobs] : headless daemon, one job per connection
+        if (argc >= 3 && std::string(argv[1]) == "--serve")
+        {
+            uint32_t max_jobs = (argc >= 4) ? static_cast<uint32_t>(std::atoi(argv[3])) : 2u;
+            painting::JobServer server(argv[2], max_jobs);
+            server.run();
+            return EXIT_SUCCESS;
+        }
+        // painting --multi-device target output runs [devices_per_gpu] : rows split across every suitable device
+        if (argc >= 5 && std::string(argv[1]) == "--multi-device")
+        {
+            painting::BatchJob job;
+            job.target = argv[2];
+            job.output = argv[3];
+            job.run_count = static_cast<uint32_t>(std::atoi(argv[4]));
+            uint32_t devices_per_gpu = (argc >= 6) ? static_cast<uint32_t>(std::atoi(argv[5])) : 1u;
+
+            VkExtent3D extent;
+            std::vector<char> target = painting::BatchRunner::loadTarget(job.target, extent);
+            painting::MultiDevicePainter painter(target.data(), extent, job, devices_per_gpu);
+            std::cout << "bands: " << painter.get_band_count() << "\n";
+            painter.run(job.run_count);
+            painter.save(job.output + ".png");
+            return EXIT_SUCCESS;
+        }
+        // painting --worker port : headless evaluation worker of a coordinator
+        if (argc >= 3 && std::string(argv[1]) == "--worker")
+        {
+            painting::RemoteWorker worker(static_cast<uint16_t>(std::atoi(argv[2])));
+            worker.run();
+            return EXIT_SUCCESS;
+        }
+        // painting --coordinator target output runs host:port[,host:port...] : candidates evaluated on the workers
+        if (argc >= 6 && std::string(argv[1]) == "--coordinator")
+        {
+            painting::BatchJob job;
+            job.target = argv[2];
+            job.output = argv[3];
+            job.run_count = static_cast<uint32_t>(std::atoi(argv[4]));
+            std::vector<std::string> addresses;
+            std::istringstream stream(argv[5]);
+            for (std::string address; std::getline(stream, address, ',');)
+            {
+                if (!address.empty())
+                {
+                    addresses.push_back(address);
+                }
+            }
+
+            VkExtent3D extent;
+            std::vector<char> target = painting::BatchRunner::loadTarget(job.target, extent);
+            painting::Coordinator coordinator(target.data(), extent, job, addresses);
+            std::cout << "workers: " << coordinator.get_worker_count() << "\n";
+            for (uint32_t i = 0; i < job.run_count; i++)
+            {
+                coordinator.run();
+            }
+            coordinator.get_stroke_log().export_json(job.output + ".json", extent);
+            coordinator.save(job.output + ".png");
+            return EXIT_SUCCESS;
+        }
+        // painting [--checkpoint file runs] [--snapshot prefix runs] [--timelapse file generations] [--export prefix] [--profile file]
+        painting::ApplicationOptions options;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string option = argv[i];
+            if (option == "--checkpoint" && i + 2 < argc)
+            {
+                options.checkpoint_file = argv[++i];
+                options.checkpoint_interval = static_cast<uint32_t>(std::atoi(argv[++i]));
+            }
+            else if (option == "--snapshot" && i + 2 < argc)
+            {
+                options.snapshot_prefix = argv[++i];
+                options.snapshot_interval = static_cast<uint32_t>(std::atoi(argv[++i]));
+            }
+            else if (option == "--timelapse" && i + 2 < argc)
+            {
+                options.timelapse_file = argv[++i];
+                options.timelapse_interval = static_cast<uint32_t>(std::atoi(argv[++i]));
+            }
+            else if (option == "--export" && i + 1 < argc)
+            {
+                options.export_prefix = argv[++i];
+            }
+            else if (option == "--profile" && i + 1 < argc)
+            {
+                options.profile_file = argv[++i];
+            }
+            else
+            {
+                std::cerr << "ignored option: " << option << "\n";
+            }
+        }
+        painting::PaintingApplication app(options);
         app.run(1024, 512);
     }
     catch (const std::exception &e)
@@ -18,4 +126,4 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -4,24 +4,30 @@
 #include "surface.h"
 #include "physical_device.h"
 #include "queue.h"
+#include "render/pipeline/pipeline_registry.h"
+#include "render/buffer/descriptor_allocator.h"
+#include "utility/trace.h"
 
 /**
  * query
 */
 namespace vkcpp
 {
-    std::mutex Device::graphics_queue_submit_mutex_;
-
     const void Device::graphics_queue_submit(const VkSubmitInfo *submit_info, int info_count, VkFence fence, const std::string &error_message) const
     {
-        graphics_queue_submit_mutex_.lock();
+        VKCPP_TRACE_SCOPE("Device::graphics_queue_submit");
+        std::lock_guard<std::mutex> lock(graphics_queue_submit_mutex_);
         // Submit to the queue
         if (vkQueueSubmit(*graphics_queue_, info_count, submit_info, fence) != VK_SUCCESS)
         {
             throw std::runtime_error(error_message);
         }
-
-        graphics_queue_submit_mutex_.unlock();
+    }
+    const void Device::graphics_queue_wait_idle() const
+    {
+        VKCPP_TRACE_SCOPE("Device::graphics_queue_wait_idle");
+        std::lock_guard<std::mutex> lock(graphics_queue_submit_mutex_);
+        vkQueueWaitIdle(*graphics_queue_);
     }
     const uint32_t Device::find_memory_type(uint32_t type_filter, VkMemoryPropertyFlags properties) const
     {
@@ -47,9 +53,13 @@ namespace vkcpp
     {
         init_device(gpu_);
         init_queues(gpu_);
+        pipeline_registry_ = std::make_unique<PipelineRegistry>(this);
+        descriptor_allocator_ = std::make_unique<DescriptorAllocator>(this);
     }
     Device::~Device()
     {
+        descriptor_allocator_.reset();
+        pipeline_registry_.reset();
         if (handle_ != VK_NULL_HANDLE)
         {
             vkDestroyDevice(handle_, nullptr);
@@ -69,6 +79,16 @@ namespace vkcpp
     {
         return present_queue_.get();
     }
+
+    PipelineRegistry *Device::get_pipeline_registry() const
+    {
+        return pipeline_registry_.get();
+    }
+
+    DescriptorAllocator *Device::get_descriptor_allocator() const
+    {
+        return descriptor_allocator_.get();
+    }
     void Device::init_device(const PhysicalDevice *gpu)
     {
         const QueueFamilyIndices &indices = gpu->get_queue_family_indices();
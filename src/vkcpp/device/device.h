@@ -11,18 +11,29 @@ namespace vkcpp
 
     class Queue;
 
+    class PipelineRegistry;
+
+    class DescriptorAllocator;
+
     /**
      *  @brief A wrapper class for VkDevice
      */
     class Device
     {
     public:
-        static std::mutex graphics_queue_submit_mutex_;
         const void graphics_queue_submit(const VkSubmitInfo *submit_info, int info_count, VkFence fence, const std::string &error_message = "failed to submit graphics queue") const;
 
+        /**
+         *  @brief vkQueueWaitIdle under the submit mutex (the queue is shared by threads)
+         */
+        const void graphics_queue_wait_idle() const;
+
         const uint32_t find_memory_type(uint32_t type_filter, VkMemoryPropertyFlags properties) const;
 
     private:
+        // the graphics queue is shared by threads, devices do not share it
+        mutable std::mutex graphics_queue_submit_mutex_;
+
         const PhysicalDevice *gpu_;
 
         std::unique_ptr<Queue> graphics_queue_{nullptr};
@@ -35,6 +46,10 @@ namespace vkcpp
 
         VkDevice handle_{VK_NULL_HANDLE};
 
+        std::unique_ptr<PipelineRegistry> pipeline_registry_{nullptr};
+
+        std::unique_ptr<DescriptorAllocator> descriptor_allocator_{nullptr};
+
     public:
         Device(const PhysicalDevice *gpu);
 
@@ -55,6 +70,10 @@ namespace vkcpp
 
         const Queue *get_present_queue() const;
 
+        PipelineRegistry *get_pipeline_registry() const;
+
+        DescriptorAllocator *get_descriptor_allocator() const;
+
         void init_device(const PhysicalDevice *gpu);
 
         void init_queues(const PhysicalDevice *gpu);
@@ -6,7 +6,8 @@
 
 namespace vkcpp
 {
-    Instance::Instance()
+    Instance::Instance(bool is_headless)
+        : is_headless_(is_headless)
     {
         init_instance();
         init_debug_messenger();
@@ -51,9 +52,12 @@ namespace vkcpp
 
     std::vector<const char *> Instance::get_extensions()
     {
-        auto [window_extensions, window_count] = MainWindow::getInstance()->get_required_instance_extensions();
-
-        std::vector<const char *> extensions(window_extensions, window_extensions + window_count);
+        std::vector<const char *> extensions;
+        if (!is_headless_)
+        {
+            auto [window_extensions, window_count] = MainWindow::getInstance()->get_required_instance_extensions();
+            extensions.assign(window_extensions, window_extensions + window_count);
+        }
 
         if (enable_validation_layers_)
         {
@@ -177,6 +181,25 @@ namespace vkcpp
         return gpus_.at(0).get();
     }
 
+    std::vector<PhysicalDevice *> Instance::get_suitable_gpus(std::vector<const char *> &requested_extensions)
+    {
+        std::vector<PhysicalDevice *> gpus;
+        for (auto &gpu : gpus_)
+        {
+            if (gpu->is_device_suitable(requested_extensions))
+            {
+                gpus.push_back(gpu.get());
+            }
+        }
+        std::stable_partition(gpus.begin(), gpus.end(), [](const PhysicalDevice *gpu)
+                              { return gpu->get_properties().deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU; });
+        if (gpus.empty())
+        {
+            throw std::runtime_error("failed to find a suitable GPU!");
+        }
+        return gpus;
+    }
+
 } // namespace vkcpp
 
 /**
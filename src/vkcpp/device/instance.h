@@ -21,6 +21,9 @@ namespace vkcpp
 
         std::vector<std::unique_ptr<PhysicalDevice>> gpus_;
 
+        // no window : no surface extensions
+        bool is_headless_{false};
+
 #ifdef NDEBUG
         const bool enable_validation_layers_ = false;
 #else
@@ -30,7 +33,7 @@ namespace vkcpp
     public:
         static const std::vector<const char *> validation_layers_;
 
-        Instance();
+        explicit Instance(bool is_headless = false);
 
         Instance(const Instance &) = delete;
 
@@ -52,7 +55,7 @@ namespace vkcpp
         bool check_validation_layer_support();
 
         /**
-        * get glfw instance extensions
+        * get glfw instance extensions (none if headless)
         */
         std::vector<const char *> get_extensions();
 
@@ -75,6 +78,7 @@ namespace vkcpp
 
         /**
          *  @brief Quries the instance for the physical devices on the machine
+         *  @param surface nullptr : headless, the graphics queue family is the present family
          */
         void query_gpus(const Surface *surface);
 
@@ -83,6 +87,11 @@ namespace vkcpp
          *  @returns A vaild PhysicalDevice  
          */
         PhysicalDevice *get_suitable_gpu(std::vector<const char *> &requested_extensions);
+
+        /**
+         *  @brief every suitable GPU, discrete GPUs first
+         */
+        std::vector<PhysicalDevice *> get_suitable_gpus(std::vector<const char *> &requested_extensions);
     }; // class Instance
 
     VkResult CreateDebugUtilsMessengerEXT(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkDebugUtilsMessengerEXT *pDebugMessenger);
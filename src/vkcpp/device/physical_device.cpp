@@ -30,9 +30,16 @@ namespace vkcpp
                 indices.graphics_family = i;
             }
 
-            // Check for present support.
+            // Check for present support (headless : no presentation, the graphics family).
             VkBool32 present_support = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(handle_, i, *surface_, &present_support);
+            if (surface_ == nullptr)
+            {
+                present_support = (queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+            }
+            else
+            {
+                vkGetPhysicalDeviceSurfaceSupportKHR(handle_, i, *surface_, &present_support);
+            }
             if (present_support && queue_family.queueCount > 0)
             {
                 indices.present_family = i;
@@ -81,6 +88,10 @@ namespace vkcpp
     SwapchainSupportDetails PhysicalDevice::query_swapchain_support() const
     {
         SwapchainSupportDetails details;
+        if (surface_ == nullptr)
+        {
+            return details;
+        }
 
         vkGetPhysicalDeviceSurfaceCapabilitiesKHR(handle_, *surface_, &details.capabilities);
 
@@ -109,8 +120,8 @@ namespace vkcpp
         extensions_ = requested_extensions;
         queue_family_indices_ = find_queue_families();
         bool extensions_supported = check_device_extension_support(requested_extensions);
-        bool swapchain_adequate = false;
-        if (extensions_supported)
+        bool swapchain_adequate = (surface_ == nullptr);
+        if (extensions_supported && surface_ != nullptr)
         {
             auto swapchain_support = query_swapchain_support();
             swapchain_adequate = !swapchain_support.formats.empty() && !swapchain_support.present_modes.empty();
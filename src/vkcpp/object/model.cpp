@@ -59,4 +59,9 @@ namespace vkcpp
     {
         vkCmdDrawIndexed(command_buffer, static_cast<uint32_t>(indices_.size()), 1, 0, 0, 0);
     }
+
+    void Model::draw_indirect(VkCommandBuffer command_buffer, VkBuffer indirect_buffer, VkDeviceSize offset)
+    {
+        vkCmdDrawIndexedIndirect(command_buffer, indirect_buffer, offset, 1, sizeof(VkDrawIndexedIndirectCommand));
+    }
 }
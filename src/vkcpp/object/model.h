@@ -45,6 +45,13 @@ namespace vkcpp
 
         void draw(VkCommandBuffer command_buffer);
 
+        /**
+         *  @brief one VkDrawIndexedIndirectCommand at offset of indirect_buffer
+         */
+        void draw_indirect(VkCommandBuffer command_buffer, VkBuffer indirect_buffer, VkDeviceSize offset);
+
+        const uint32_t get_index_count() const { return static_cast<uint32_t>(indices_.size()); }
+
     }; // class Model
 } // namespace vkcpp
 
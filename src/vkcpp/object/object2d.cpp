@@ -5,11 +5,13 @@
 #include "object/camera/main_camera.h"
 #include "render/image/image.h"
 #include "render/image/image2d.h"
+#include "render/image/image_atlas.h"
 #include "render/render_stage.h"
 #include "render/swapchain/swapchain.h"
 #include "render/command/command_pool.h"
 #include "render/command/command_buffers.h"
 #include "render/pipeline/graphics_pipeline.h"
+#include "render/pipeline/pipeline_registry.h"
 #include "object/camera/camera.h"
 
 namespace vkcpp
@@ -71,6 +73,8 @@ namespace vkcpp
           current_texture_(a->current_texture_)
     {
         model_ = a->model_;
+        atlas_region_count_ = a->atlas_region_count_;
+        atlas_region_ = a->atlas_region_;
         graphics_pipeline_ = a->graphics_pipeline_;
         int size = static_cast<int>(a->texture_.size());
         for (int i = 0; i < size; i++)
@@ -82,6 +86,20 @@ namespace vkcpp
             texture_[current_texture_].get(),
             framebuffers_size_);
     }
+    Object2D::Object2D(const Device *device,
+                       const RenderStage *render_stage,
+                       const CommandPool *command_pool,
+                       const std::vector<const char *> &texture_files,
+                       VkFormat format)
+        : device_(device), render_stage_(render_stage), command_pool_(command_pool), texture_file_(nullptr), current_texture_(0)
+    {
+        texture_.push_back(std::make_shared<ImageAtlas>(
+            device_,
+            command_pool_,
+            texture_files,
+            format));
+        init_object2d();
+    }
     Object2D::Object2D(const Device *device,
                        const RenderStage *render_stage,
                        const CommandPool *command_pool,
@@ -140,6 +158,20 @@ namespace vkcpp
     {
         return current_texture_;
     }
+    const int Object2D::get_atlas_region_count() const
+    {
+        return atlas_region_count_;
+    }
+    const VkDrawIndexedIndirectCommand Object2D::get_indirect_command() const
+    {
+        VkDrawIndexedIndirectCommand command{};
+        command.indexCount = model_->get_index_count();
+        command.instanceCount = 1;
+        command.firstIndex = 0;
+        command.vertexOffset = atlas_region_ * 4;
+        command.firstInstance = 0;
+        return command;
+    }
 
     void Object2D::init_color(const glm::vec4 &color)
     {
@@ -220,8 +252,34 @@ namespace vkcpp
         init_dependency_renderpass(render_stage_);
     }
 
+    static std::vector<shader::attribute::Vertex> makeQuad(float w, float h, float u0, float v0, float u1, float v1)
+    {
+        // interleaving vertex attributes
+        return {
+            {{-w, -h, 0.0f}, {1.0f, 1.0f, 1.0f}, {u0, v0}},
+            {{w, -h, 0.0f}, {1.0f, 1.0f, 1.0f}, {u1, v0}},
+            {{w, h, 0.0f}, {1.0f, 1.0f, 1.0f}, {u1, v1}},
+            {{-w, h, 0.0f}, {1.0f, 1.0f, 1.0f}, {u0, v1}}};
+    }
+
     void Object2D::load_model()
     {
+        if (auto atlas = dynamic_cast<const ImageAtlas *>(texture_[current_texture_].get()))
+        {
+            std::vector<shader::attribute::Vertex> vertices;
+            for (auto &region : atlas->get_regions())
+            {
+                std::vector<shader::attribute::Vertex> quad = makeQuad(
+                    static_cast<float>(region.width) / 2.0f,
+                    static_cast<float>(region.height) / 2.0f,
+                    region.u0, region.v0, region.u1, region.v1);
+                vertices.insert(vertices.end(), quad.begin(), quad.end());
+            }
+            atlas_region_count_ = atlas->get_region_count();
+            atlas_region_ = 0;
+            model_ = std::make_shared<Model>(device_, command_pool_, vertices);
+            return;
+        }
         auto [width, height] = texture_[current_texture_]->get_size();
 
 #ifdef _DEBUG__
@@ -230,12 +288,7 @@ namespace vkcpp
 
         float w = static_cast<float>(width) / 2.0f, h = static_cast<float>(height) / 2.0f;
 
-        // interleaving vertex attributes
-        std::vector<shader::attribute::Vertex> vertices = {
-            {{-w, -h, 0.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f}},
-            {{w, -h, 0.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, 0.0f}},
-            {{w, h, 0.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f}},
-            {{-w, h, 0.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f}}};
+        std::vector<shader::attribute::Vertex> vertices = makeQuad(w, h, 0.0f, 0.0f, 1.0f, 1.0f);
 
         model_ = std::make_shared<Model>(device_, command_pool_, vertices);
     }
@@ -260,8 +313,7 @@ namespace vkcpp
             graphics_pipeline_.reset();
         }
 
-        graphics_pipeline_ = std::make_unique<GraphicsPipeline>(
-            device_,
+        graphics_pipeline_ = device_->get_pipeline_registry()->get_graphics_pipeline(
             render_stage_,
             uniform_buffers_.get(),
             vert_shader_file_,
@@ -278,6 +330,7 @@ namespace vkcpp
     void Object2D::destroy_object2d()
     {
         model_ = nullptr;
+        atlas_region_count_ = 0;
         int size = texture_.size();
         for (int i = 0; i < size; i++)
         {
@@ -307,6 +360,23 @@ namespace vkcpp
         model_->draw(command_buffer);
     }
 
+    void Object2D::draw_indirect_without_bind_graphics(VkCommandBuffer command_buffer, int idx, VkBuffer indirect_buffer, VkDeviceSize offset)
+    {
+        model_->bind(command_buffer);
+
+        vkCmdBindDescriptorSets(
+            command_buffer,
+            graphics_pipeline_->get_pipeline_bind_point(),
+            graphics_pipeline_->get_pipeline_layout(),
+            0,
+            1,
+            &uniform_buffers_->get_sets()[idx],
+            0,
+            nullptr);
+
+        model_->draw_indirect(command_buffer, indirect_buffer, offset);
+    }
+
     void Object2D::draw(VkCommandBuffer command_buffer, const GraphicsPipeline *graphics_pipeline, int idx)
     {
         graphics_pipeline->bind_pipeline(command_buffer);
@@ -382,10 +452,25 @@ namespace vkcpp
         current_texture_ = idx;
         uniform_buffers_->set_image(texture_[idx].get(), ubo_idx);
     }
+    void Object2D::change_atlas_region(int idx)
+    {
+        if (atlas_region_count_ <= idx)
+        {
+#ifdef _DEBUG__
+            std::cout << "failed to change_atlas_region! out of bounds!\n";
+#endif
+            return;
+        }
+        atlas_region_ = idx;
+    }
     void Object2D::sub_texture(const char *path)
     {
         texture_[current_texture_]->sub_texture_image(path);
     }
+    void Object2D::sub_texture_pixels(const char *pixels, VkDeviceSize size)
+    {
+        texture_[current_texture_]->sub_texture_pixels(pixels, size);
+    }
     // TODO: fix hard coding "format = RGBA SRGB"
     void Object2D::sub_texture(VkImage image, VkExtent3D extent)
     {
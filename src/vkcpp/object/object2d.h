@@ -4,6 +4,7 @@
 #include "vulkan_header.h"
 #include "shader_attribute.hpp"
 #include "render/buffer/uniform_buffers.hpp"
+#include "utility/image_encoder.h"
 
 namespace vkcpp
 {
@@ -57,11 +58,16 @@ namespace vkcpp
 
         std::vector<std::shared_ptr<Image2D>> texture_;
 
-        // TODO : renderpass compatiblility and check
+        // shared with every object of the same pipeline state (PipelineRegistry)
         std::shared_ptr<GraphicsPipeline> graphics_pipeline_{nullptr};
 
         std::shared_ptr<Model> model_{nullptr};
 
+        // atlas : one quad (4 vertices) per region in model_, selected by vertexOffset
+        int atlas_region_count_{0};
+
+        int atlas_region_{0};
+
         uint32_t framebuffers_size_{0};
 
         TransformComponent transform_{};
@@ -89,6 +95,15 @@ namespace vkcpp
                  const char *texture_file = nullptr,
                  VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
 
+        /**
+         *  texture_files are packed into one atlas, select with change_atlas_region
+         */
+        Object2D(const Device *device,
+                 const RenderStage *render_stage,
+                 const CommandPool *command_pool,
+                 const std::vector<const char *> &texture_files,
+                 VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+
         Object2D(const Object2D *);
 
         Object2D(const Object2D &) = delete;
@@ -115,6 +130,17 @@ namespace vkcpp
 
         const int get_current_texture_idx() const;
 
+        const int get_atlas_region_count() const;
+
+        Model *get_model() const { return model_.get(); }
+
+        const Image2D *get_texture() const { return texture_[current_texture_].get(); }
+
+        /**
+         *  @brief draw parameters of the current atlas region (instanceCount = 1)
+         */
+        const VkDrawIndexedIndirectCommand get_indirect_command() const;
+
         UniformBuffers<shader::attribute::TransformUBO> &get_mutable_uniform_buffers();
 
         void init_color(const glm::vec4 &color);
@@ -148,6 +174,9 @@ namespace vkcpp
         // Draw with internal pipeline and UBO (without bind graphics pipeline)
         virtual void draw_without_bind_graphics(VkCommandBuffer command_buffer, int idx);
 
+        // Draw with internal UBO and parameters from indirect_buffer (without bind graphics pipeline)
+        void draw_indirect_without_bind_graphics(VkCommandBuffer command_buffer, int idx, VkBuffer indirect_buffer, VkDeviceSize offset);
+
         // Draw with external UBO and bind internal graphics pipeline (bind internal graphics pipeline)
         virtual void draw(VkCommandBuffer command_buffer, const UniformBuffers<shader::attribute::TransformUBO> *uniform_buffers, int idx);
 
@@ -163,61 +192,33 @@ namespace vkcpp
 
         void change_texture(int idx, int ubo_idx);
 
+        /**
+         *  select the quad of the region, no descriptor update
+         *  recorded draws follow it only through get_indirect_command
+         */
+        void change_atlas_region(int idx);
+
         void sub_texture(const char *path);
 
         void sub_texture(VkImage image, VkExtent3D extent);
 
+        void sub_texture_pixels(const char *pixels, VkDeviceSize size);
+
         /**
          * @return staging image, memory, data, rowpitch
          */
         std::tuple<VkBuffer, VkDeviceMemory, const char *, VkDeviceSize> map_read_image_memory();
         void unmap_buffer_memory(VkBuffer buffer, VkDeviceMemory memory);
 
+        /**
+         *  @brief encode by the file extension (png, qoi, otherwise ppm), bgr formats are swizzled unless blitted
+         */
         void data_to_file(const char *filename, const char *data, const VkExtent3D &extent, VkFormat image_format, bool supports_blit, VkDeviceSize row_pitch)
         {
-
-            std::ofstream file(filename, std::ios::out | std::ios::binary);
-
-            // ppm header
-            file << "P6\n"
-                 << extent.width << "\n"
-                 << extent.height << "\n"
-                 << 255 << "\n";
-
-            // If source is BGR (destination is always RGB) and we can't use blit (which does automatic conversion), we'll have to manually swizzle color components
-            bool colorSwizzle = false;
-            // Check if source is BGR
-            // Note: Not complete, only contains most common and basic BGR surface formats for demonstration purposes
-            if (!supports_blit)
-            {
-                std::vector<VkFormat> formatsBGR = {VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_B8G8R8A8_SNORM};
-                colorSwizzle = (std::find(formatsBGR.begin(), formatsBGR.end(), image_format) != formatsBGR.end());
-            }
-
-            // ppm binary pixel data
-            for (uint32_t y = 0; y < extent.height; y++)
+            if (!encode::file(filename, data, extent, row_pitch, supports_blit ? VK_FORMAT_R8G8B8A8_SRGB : image_format))
             {
-                unsigned int *row = (unsigned int *)data;
-                for (uint32_t x = 0; x < extent.width; x++)
-                {
-                    if (colorSwizzle)
-                    {
-                        file.write((char *)row + 2, 1);
-                        file.write((char *)row + 1, 1);
-                        file.write((char *)row, 1);
-                    }
-                    else
-                    {
-                        file.write((char *)row, 3);
-                    }
-                    row++;
-                }
-                data += row_pitch;
+                std::cerr << "failed to write image: " << filename << "\n";
             }
-            file.close();
-#ifdef _DEBUG__
-            std::cout << "Screenshot saved to disk" << std::endl;
-#endif
         }
     }; // class Object
 } // namespace vkcpp
@@ -0,0 +1,129 @@
+#include "descriptor_allocator.h"
+
+#include "device/device.h"
+
+namespace vkcpp
+{
+    DescriptorAllocator::DescriptorAllocator(const Device *device)
+        : device_(device)
+    {
+        // descriptors per set
+        pool_size_ratios_ = {
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0.5f},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0.5f}};
+    }
+
+    DescriptorAllocator::~DescriptorAllocator()
+    {
+        destroy();
+    }
+
+    VkDescriptorPool DescriptorAllocator::create_pool()
+    {
+        std::vector<VkDescriptorPoolSize> pool_sizes;
+        for (auto &[type, ratio] : pool_size_ratios_)
+        {
+            pool_sizes.push_back({type, static_cast<uint32_t>(ratio * SETS_PER_POOL_)});
+        }
+
+        VkDescriptorPoolCreateInfo pool_info{};
+        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+        pool_info.pPoolSizes = pool_sizes.data();
+        pool_info.maxSets = SETS_PER_POOL_;
+
+        VkDescriptorPool pool;
+        if (vkCreateDescriptorPool(*device_, &pool_info, nullptr, &pool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create descriptor pool!");
+        }
+        return pool;
+    }
+
+    VkResult DescriptorAllocator::try_allocate(VkDescriptorPool pool, const std::vector<VkDescriptorSetLayout> &layouts, std::vector<VkDescriptorSet> &sets)
+    {
+        VkDescriptorSetAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        alloc_info.descriptorPool = pool;
+        alloc_info.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+        alloc_info.pSetLayouts = layouts.data();
+
+        sets.resize(layouts.size());
+        return vkAllocateDescriptorSets(*device_, &alloc_info, sets.data());
+    }
+
+    VkDescriptorPool DescriptorAllocator::allocate(const std::vector<VkDescriptorSetLayout> &layouts, std::vector<VkDescriptorSet> &sets)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // current pool, then a pool with freed sets
+        std::vector<size_t> candidates;
+        if (pools_.size() > 0)
+        {
+            candidates.push_back(current_pool_);
+        }
+        for (size_t i = 0; i < pools_.size(); i++)
+        {
+            if (i != current_pool_ && has_freed_sets_[i])
+            {
+                candidates.push_back(i);
+            }
+        }
+        for (size_t idx : candidates)
+        {
+            VkResult result = try_allocate(pools_[idx], layouts, sets);
+            if (result == VK_SUCCESS)
+            {
+                current_pool_ = idx;
+                return pools_[idx];
+            }
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+            {
+                throw std::runtime_error("failed to allocate descriptor sets!");
+            }
+            has_freed_sets_[idx] = false;
+        }
+
+        // grow
+        pools_.push_back(create_pool());
+        has_freed_sets_.push_back(false);
+        current_pool_ = pools_.size() - 1;
+        if (try_allocate(pools_.back(), layouts, sets) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate descriptor sets!");
+        }
+        return pools_.back();
+    }
+
+    void DescriptorAllocator::free(VkDescriptorPool pool, const std::vector<VkDescriptorSet> &sets)
+    {
+        if (pool == VK_NULL_HANDLE || sets.size() == 0)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        vkFreeDescriptorSets(*device_, pool, static_cast<uint32_t>(sets.size()), sets.data());
+        auto it = std::find(pools_.begin(), pools_.end(), pool);
+        if (it != pools_.end())
+        {
+            has_freed_sets_[it - pools_.begin()] = true;
+        }
+    }
+
+    void DescriptorAllocator::destroy()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto &pool : pools_)
+        {
+            vkDestroyDescriptorPool(*device_, pool, nullptr);
+        }
+        pools_.clear();
+        has_freed_sets_.clear();
+        current_pool_ = 0;
+    }
+} // namespace vkcpp
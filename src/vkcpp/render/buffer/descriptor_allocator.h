@@ -0,0 +1,55 @@
+#ifndef VKCPP_RENDER_BUFFER_DESCRIPTOR_ALLOCATOR_H
+#define VKCPP_RENDER_BUFFER_DESCRIPTOR_ALLOCATOR_H
+
+#include "vulkan_header.h"
+
+namespace vkcpp
+{
+    class Device;
+
+    /**
+     *  Device-wide descriptor set allocator.
+     *  List of large pools (FREE_DESCRIPTOR_SET) : sets come from the current pool,
+     *  when it is full from a pool which freed sets since it was full, else a new pool is pushed.
+     */
+    class DescriptorAllocator
+    {
+    private:
+        static constexpr uint32_t SETS_PER_POOL_ = 256;
+
+        const Device *device_{nullptr};
+
+        std::mutex mutex_;
+
+        std::vector<std::pair<VkDescriptorType, float>> pool_size_ratios_;
+
+        std::vector<VkDescriptorPool> pools_;
+
+        size_t current_pool_{0};
+
+        // pools_[i] freed sets since its last failed allocation
+        std::vector<bool> has_freed_sets_;
+
+    public:
+        DescriptorAllocator(const Device *device);
+
+        ~DescriptorAllocator();
+
+        /**
+         *  @brief allocate layouts.size() sets that live until free()
+         *  @return pool the sets came from
+         */
+        VkDescriptorPool allocate(const std::vector<VkDescriptorSetLayout> &layouts, std::vector<VkDescriptorSet> &sets);
+
+        void free(VkDescriptorPool pool, const std::vector<VkDescriptorSet> &sets);
+
+        void destroy();
+
+    private:
+        VkDescriptorPool create_pool();
+
+        VkResult try_allocate(VkDescriptorPool pool, const std::vector<VkDescriptorSetLayout> &layouts, std::vector<VkDescriptorSet> &sets);
+    }; // class DescriptorAllocator
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_RENDER_BUFFER_DESCRIPTOR_ALLOCATOR_H
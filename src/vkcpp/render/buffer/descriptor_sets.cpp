@@ -1,19 +1,19 @@
 #include "descriptor_sets.h"
 
 #include "device/device.h"
+#include "descriptor_allocator.h"
 
 namespace vkcpp
 {
-    DescriptorSets::DescriptorSets(const Device *device, uint32_t size)
-        : device_(device), size_(size)
+    DescriptorSets::DescriptorSets(const Device *device, uint32_t size, VkDescriptorType buffer_type)
+        : device_(device), buffer_type_(buffer_type), size_(size)
     {
         init_layout();
-        init_pool();
         init_descriptor_sets();
     }
     DescriptorSets::~DescriptorSets()
     {
-        destroy_pool();
+        destroy_descriptor_sets();
         destroy_layout();
     }
 
@@ -23,7 +23,7 @@ namespace vkcpp
         VkDescriptorSetLayoutBinding &layout_binding = layout_bindings_[0];
         layout_binding.binding = 0;
         layout_binding.descriptorCount = 1;
-        layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        layout_binding.descriptorType = buffer_type_;
         layout_binding.pImmutableSamplers = nullptr;
         layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
@@ -38,70 +38,29 @@ namespace vkcpp
     void DescriptorSets::init_layout()
     {
         init_layout_bindings();
-        VkDescriptorSetLayout layout;
 
-        VkDescriptorSetLayoutCreateInfo layout_info{};
-        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layout_info.bindingCount = layout_bindings_.size();
-        layout_info.pBindings = layout_bindings_.data();
-
-        if (vkCreateDescriptorSetLayout(*device_, &layout_info, nullptr, &layout) != VK_SUCCESS)
-        {
-            throw std::runtime_error("failed to create descriptor set layout!");
-        }
-        layouts_ = std::vector<VkDescriptorSetLayout>(size_, layout);
-    }
-
-    void DescriptorSets::init_pool()
-    {
-        std::array<VkDescriptorPoolSize, 2> pool_sizes{};
-        pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        pool_sizes[0].descriptorCount = size_;
-        pool_sizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        pool_sizes[1].descriptorCount = size_;
-
-        VkDescriptorPoolCreateInfo pool_info{};
-        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
-        pool_info.pPoolSizes = pool_sizes.data();
-        pool_info.maxSets = size_;
-
-        if (vkCreateDescriptorPool(*device_, &pool_info, nullptr, &pool_) != VK_SUCCESS)
-        {
-            throw std::runtime_error("failed to create descriptor pool!");
-        }
+        layout_ = device_->get_pipeline_registry()->get_descriptor_set_layout(layout_bindings_);
+        layouts_ = std::vector<VkDescriptorSetLayout>(size_, layout_.get());
     }
 
     void DescriptorSets::init_descriptor_sets()
     {
-        VkDescriptorSetAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        alloc_info.descriptorPool = pool_;
-        alloc_info.descriptorSetCount = size_;
-        alloc_info.pSetLayouts = layouts_.data();
-
-        descriptor_sets_.resize(size_);
-        if (vkAllocateDescriptorSets(*device_, &alloc_info, descriptor_sets_.data()) != VK_SUCCESS)
-        {
-            throw std::runtime_error("failed to allocate descriptor sets!");
-        }
+        pool_ = device_->get_descriptor_allocator()->allocate(layouts_, descriptor_sets_);
     }
 
     void DescriptorSets::destroy_layout()
     {
-        if (layouts_.size() > 0)
-        {
-            vkDestroyDescriptorSetLayout(*device_, layouts_[0], nullptr);
-        }
         layouts_.resize(0);
+        layout_ = nullptr;
     }
 
-    void DescriptorSets::destroy_pool()
+    void DescriptorSets::destroy_descriptor_sets()
     {
         if (pool_ != VK_NULL_HANDLE)
         {
-            vkDestroyDescriptorPool(*device_, pool_, nullptr);
+            device_->get_descriptor_allocator()->free(pool_, descriptor_sets_);
             pool_ = VK_NULL_HANDLE;
         }
+        descriptor_sets_.resize(0);
     }
 }
\ No newline at end of file
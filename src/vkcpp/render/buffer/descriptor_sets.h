@@ -2,12 +2,14 @@
 #define VKCPP_RENDER_BUFFER_DESCRIPTOR_SET_H
 
 #include "vulkan_header.h"
+#include "render/pipeline/pipeline_registry.h"
 
 namespace vkcpp
 {
     class Device;
     /**
-     * layouts_ : point same layout. therefore destroy one layout.
+     * layouts_ : point same layout, shared through the device pipeline registry.
+     * descriptor_sets_ : allocated from the device descriptor allocator, pool_ is the owner pool.
      */
     class DescriptorSets
     {
@@ -16,6 +18,11 @@ namespace vkcpp
 
         std::vector<VkDescriptorSetLayoutBinding> layout_bindings_;
 
+        // binding 0 : UNIFORM_BUFFER or UNIFORM_BUFFER_DYNAMIC
+        VkDescriptorType buffer_type_{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER};
+
+        PipelineRegistry::DescriptorSetLayout layout_{nullptr};
+
         std::vector<VkDescriptorSetLayout> layouts_;
 
         std::vector<VkDescriptorSet> descriptor_sets_;
@@ -25,7 +32,7 @@ namespace vkcpp
         uint32_t size_{0};
 
     public:
-        DescriptorSets(const Device *device, uint32_t size);
+        DescriptorSets(const Device *device, uint32_t size, VkDescriptorType buffer_type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
 
         virtual ~DescriptorSets();
 
@@ -37,13 +44,11 @@ namespace vkcpp
 
         void init_layout();
 
-        void init_pool();
-
         void init_descriptor_sets();
 
         void destroy_layout();
 
-        void destroy_pool();
+        void destroy_descriptor_sets();
 
     }; // class
 
@@ -0,0 +1,62 @@
+#ifndef VKCPP_RENDER_BUFFER_DYNAMIC_UNIFORM_BUFFERS_HPP
+#define VKCPP_RENDER_BUFFER_DYNAMIC_UNIFORM_BUFFERS_HPP
+
+#include "descriptor_sets.h"
+#include "device/device.h"
+#include "device/physical_device.h"
+#include "render/image/image.h"
+
+#include "utility/create.h"
+
+namespace vkcpp
+{
+    /**
+     *  UNIFORM_BUFFER_DYNAMIC version of UniformBuffers.
+     *  One descriptor set and one mapped buffer of capacity slots per frame,
+     *  a slot is selected with get_dynamic_offset when the set is bound.
+     *  The shader side is the same as a plain uniform buffer.
+     */
+    template <typename T>
+    class DynamicUniformBuffers : public DescriptorSets
+    {
+    private:
+        const Image *image_;
+
+        uint32_t capacity_{0};
+
+        // sizeof(T) aligned to minUniformBufferOffsetAlignment
+        uint32_t stride_{0};
+
+        std::vector<VkBuffer> handle_;
+
+        std::vector<VkDeviceMemory> memory_;
+
+        std::vector<char *> mapped_;
+
+    public:
+        DynamicUniformBuffers() = delete;
+
+        DynamicUniformBuffers(const Device *device, const Image *image, uint32_t size, uint32_t capacity);
+
+        virtual ~DynamicUniformBuffers();
+
+        const uint32_t get_capacity() const { return capacity_; }
+
+        const uint32_t get_dynamic_offset(uint32_t slot) const { return slot * stride_; }
+
+        void init_uniform_buffers();
+
+        void destroy_uniform_buffers();
+
+        void update_uniform_buffer(uint32_t idx, uint32_t slot, const T &src_data);
+
+        void update_descriptor(int i);
+
+        void update_descriptor();
+    };
+
+} // namespace vkcpp
+
+#include "dynamic_uniform_buffers.tpp"
+
+#endif // #ifndef VKCPP_RENDER_BUFFER_DYNAMIC_UNIFORM_BUFFERS_HPP
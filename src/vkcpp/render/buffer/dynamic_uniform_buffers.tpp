@@ -0,0 +1,113 @@
+namespace vkcpp
+{
+    template <typename T>
+    DynamicUniformBuffers<T>::DynamicUniformBuffers(const Device *device, const Image *image, uint32_t size, uint32_t capacity)
+        : DescriptorSets(device, size, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC), image_(image), capacity_(capacity)
+    {
+        VkDeviceSize alignment = device_->get_gpu().get_properties().limits.minUniformBufferOffsetAlignment;
+        stride_ = static_cast<uint32_t>(sizeof(T));
+        if (alignment > 0)
+        {
+            stride_ = static_cast<uint32_t>((sizeof(T) + alignment - 1) & ~(alignment - 1));
+        }
+        init_uniform_buffers();
+        update_descriptor();
+    }
+
+    template <typename T>
+    DynamicUniformBuffers<T>::~DynamicUniformBuffers()
+    {
+        destroy_uniform_buffers();
+    }
+
+    template <typename T>
+    void DynamicUniformBuffers<T>::init_uniform_buffers()
+    {
+        if (handle_.size() != 0)
+        {
+            destroy_uniform_buffers();
+        }
+        VkDeviceSize buffer_size = static_cast<VkDeviceSize>(stride_) * capacity_;
+        handle_.resize(size_, VK_NULL_HANDLE);
+        memory_.resize(size_, VK_NULL_HANDLE);
+        mapped_.resize(size_, nullptr);
+        for (uint32_t i = 0; i < size_; i++)
+        {
+            create::buffer(device_,
+                           buffer_size,
+                           VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                           handle_[i],
+                           memory_[i]);
+            vkMapMemory(*device_, memory_[i], 0, buffer_size, 0, (void **)&mapped_[i]);
+        }
+    }
+
+    template <typename T>
+    void DynamicUniformBuffers<T>::destroy_uniform_buffers()
+    {
+        for (size_t i = 0; i < handle_.size(); i++)
+        {
+            vkUnmapMemory(*device_, memory_[i]);
+            vkDestroyBuffer(*device_, handle_[i], nullptr);
+            vkFreeMemory(*device_, memory_[i], nullptr);
+        }
+        handle_.resize(0);
+        memory_.resize(0);
+        mapped_.resize(0);
+    }
+
+    template <typename T>
+    void DynamicUniformBuffers<T>::update_uniform_buffer(uint32_t idx, uint32_t slot, const T &src_data)
+    {
+        if (idx >= handle_.size() || slot >= capacity_)
+        {
+            throw std::runtime_error("failed to update dynamic ubo! out of bounds");
+        }
+        memcpy(mapped_[idx] + get_dynamic_offset(slot), &src_data, sizeof(T));
+    }
+
+    template <typename T>
+    void DynamicUniformBuffers<T>::update_descriptor(int i)
+    {
+        VkDescriptorBufferInfo buffer_info{};
+        buffer_info.buffer = handle_[i];
+        buffer_info.offset = 0;
+        buffer_info.range = sizeof(T);
+
+        VkDescriptorImageInfo image_info{};
+        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        image_info.imageView = image_->get_image_view();
+        image_info.sampler = image_->get_sampler();
+
+        std::array<VkWriteDescriptorSet, 2> descriptor_writes{};
+
+        descriptor_writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_writes[0].dstSet = descriptor_sets_[i];
+        descriptor_writes[0].dstBinding = 0;
+        descriptor_writes[0].dstArrayElement = 0;
+        descriptor_writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        descriptor_writes[0].descriptorCount = 1;
+        descriptor_writes[0].pBufferInfo = &buffer_info;
+
+        descriptor_writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_writes[1].dstSet = descriptor_sets_[i];
+        descriptor_writes[1].dstBinding = 1;
+        descriptor_writes[1].dstArrayElement = 0;
+        descriptor_writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptor_writes[1].descriptorCount = 1;
+        descriptor_writes[1].pImageInfo = &image_info;
+
+        vkUpdateDescriptorSets(*device_, static_cast<uint32_t>(descriptor_writes.size()), descriptor_writes.data(), 0, nullptr);
+    }
+
+    template <typename T>
+    void DynamicUniformBuffers<T>::update_descriptor()
+    {
+        for (size_t i = 0; i < handle_.size(); i++)
+        {
+            update_descriptor(i);
+        }
+    }
+
+} // namespace vkcpp
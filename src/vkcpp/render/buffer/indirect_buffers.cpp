@@ -0,0 +1,72 @@
+#include "indirect_buffers.h"
+
+#include "device/device.h"
+
+#include "utility/create.h"
+
+namespace vkcpp
+{
+    IndirectBuffers::IndirectBuffers(const Device *device, uint32_t size, uint32_t capacity)
+        : device_(device), capacity_(capacity)
+    {
+        init_indirect_buffers(size);
+    }
+
+    IndirectBuffers::~IndirectBuffers()
+    {
+        destroy_indirect_buffers();
+    }
+
+    void IndirectBuffers::init_indirect_buffers(uint32_t size)
+    {
+        VkDeviceSize buffer_size = static_cast<VkDeviceSize>(capacity_) * STRIDE_;
+
+        handle_.resize(size, VK_NULL_HANDLE);
+        memory_.resize(size, VK_NULL_HANDLE);
+        mapped_.resize(size, nullptr);
+        for (uint32_t i = 0; i < size; i++)
+        {
+            create::buffer(device_,
+                           buffer_size,
+                           VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                           handle_[i],
+                           memory_[i]);
+            vkMapMemory(*device_, memory_[i], 0, buffer_size, 0, (void **)&mapped_[i]);
+            memset(mapped_[i], 0, static_cast<size_t>(buffer_size));
+        }
+    }
+
+    void IndirectBuffers::set_command(int idx, uint32_t draw_idx, const VkDrawIndexedIndirectCommand &command)
+    {
+        if (draw_idx >= capacity_)
+        {
+            throw std::runtime_error("failed to set indirect command! out of bounds");
+        }
+        mapped_[idx][draw_idx] = command;
+    }
+
+    void IndirectBuffers::set_draw_count(int idx, uint32_t count)
+    {
+        for (uint32_t i = count; i < capacity_; i++)
+        {
+            mapped_[idx][i].instanceCount = 0;
+        }
+    }
+
+    void IndirectBuffers::destroy_indirect_buffers()
+    {
+        for (size_t i = 0; i < handle_.size(); i++)
+        {
+            if (mapped_[i] != nullptr)
+            {
+                vkUnmapMemory(*device_, memory_[i]);
+            }
+            vkDestroyBuffer(*device_, handle_[i], nullptr);
+            vkFreeMemory(*device_, memory_[i], nullptr);
+        }
+        handle_.clear();
+        memory_.clear();
+        mapped_.clear();
+    }
+} // namespace vkcpp
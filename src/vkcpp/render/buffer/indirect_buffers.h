@@ -0,0 +1,57 @@
+#ifndef VKCPP_RENDER_BUFFER_INDIRECT_BUFFERS_H
+#define VKCPP_RENDER_BUFFER_INDIRECT_BUFFERS_H
+
+#include "vulkan_header.h"
+
+namespace vkcpp
+{
+    class Device;
+
+    /**
+     *  Host visible VkDrawIndexedIndirectCommand arrays, one per command buffer (persistently mapped).
+     *  Draw parameters are written before submit, so recorded command buffers never change.
+     *  instanceCount == 0 : the draw is disabled.
+     */
+    class IndirectBuffers
+    {
+    public:
+        static constexpr uint32_t STRIDE_ = sizeof(VkDrawIndexedIndirectCommand);
+
+    private:
+        const Device *device_{nullptr};
+
+        uint32_t capacity_{0};
+
+        std::vector<VkBuffer> handle_;
+
+        std::vector<VkDeviceMemory> memory_;
+
+        std::vector<VkDrawIndexedIndirectCommand *> mapped_;
+
+    public:
+        IndirectBuffers(const Device *device, uint32_t size, uint32_t capacity);
+
+        IndirectBuffers(const IndirectBuffers &) = delete;
+
+        ~IndirectBuffers();
+
+        const VkBuffer &get_buffer(int idx) const { return handle_[idx]; }
+
+        const uint32_t get_capacity() const { return capacity_; }
+
+        const VkDeviceSize get_offset(uint32_t draw_idx) const { return static_cast<VkDeviceSize>(draw_idx) * STRIDE_; }
+
+        void set_command(int idx, uint32_t draw_idx, const VkDrawIndexedIndirectCommand &command);
+
+        /**
+         *  @brief disable draws in [count, capacity)
+         */
+        void set_draw_count(int idx, uint32_t count);
+
+        void init_indirect_buffers(uint32_t size);
+
+        void destroy_indirect_buffers();
+    }; // class IndirectBuffers
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_RENDER_BUFFER_INDIRECT_BUFFERS_H
@@ -23,7 +23,6 @@ namespace vkcpp
 
     void CommandBuffers::endSingleTimeCmd(CommandBuffers &cmd_buffer)
     {
-        const VkQueue &graphics_queue = *(cmd_buffer.get_device().get_graphics_queue());
         cmd_buffer.end_command_buffer(0);
 
         VkSubmitInfo submit_info{};
@@ -33,7 +32,7 @@ namespace vkcpp
 
         cmd_buffer.get_device().graphics_queue_submit(&submit_info, 1, VK_NULL_HANDLE, "failed to submit in end single time!");
 
-        vkQueueWaitIdle(graphics_queue);
+        cmd_buffer.get_device().graphics_queue_wait_idle();
 
         cmd_buffer.free_command_buffers();
     }
@@ -205,11 +204,11 @@ namespace vkcpp
             VkImageBlit blig_region{};
             blig_region.srcSubresource = src_subresource;
             blig_region.srcOffsets[0] = src_offset;
-            blig_region.srcOffsets[1] = blit_size;
+            blig_region.srcOffsets[1] = {src_offset.x + blit_size.x, src_offset.y + blit_size.y, src_offset.z + blit_size.z};
 
             blig_region.dstSubresource = dst_subresource;
             blig_region.dstOffsets[0] = dst_offset;
-            blig_region.dstOffsets[1] = blit_size;
+            blig_region.dstOffsets[1] = {dst_offset.x + blit_size.x, dst_offset.y + blit_size.y, dst_offset.z + blit_size.z};
 
             // Issue the blit command
             vkCmdBlitImage(
@@ -311,6 +310,11 @@ namespace vkcpp
         render_stage->begin_render_pass(handle_[command_buffer_idx], command_buffer_idx);
     }
 
+    void CommandBuffers::begin_render_pass(int command_buffer_idx, const RenderStage *render_stage, const VkRect2D &render_area)
+    {
+        render_stage->begin_render_pass(handle_[command_buffer_idx], command_buffer_idx, render_area);
+    }
+
     void CommandBuffers::bind_pipeline(int command_buffer_idx, const Pipeline *pipeline)
     {
         pipeline->bind_pipeline(handle_[command_buffer_idx]);
@@ -115,6 +115,8 @@ namespace vkcpp
 
         void begin_render_pass(int command_buffer_idx, const RenderStage *render_stage);
 
+        void begin_render_pass(int command_buffer_idx, const RenderStage *render_stage, const VkRect2D &render_area);
+
         void bind_pipeline(int command_buffer_idx, const Pipeline *pipeline);
 
         void end_render_pass(int command_buffer_idx, const RenderStage *render_stage);
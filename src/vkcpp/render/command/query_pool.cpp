@@ -0,0 +1,136 @@
+#include "query_pool.h"
+
+#include "device/device.h"
+#include "device/physical_device.h"
+
+namespace vkcpp
+{
+    QueryPool::QueryPool(const Device *device, VkQueryType type, uint32_t count, VkQueryPipelineStatisticFlags statistics)
+        : device_(device), type_(type), count_(count), statistics_(statistics)
+    {
+        const PhysicalDevice &gpu = device_->get_gpu();
+        if (type_ == VK_QUERY_TYPE_TIMESTAMP)
+        {
+            const QueueFamilyIndices &indices = gpu.get_queue_family_indices();
+            uint32_t valid_bits = gpu.get_queue_family_properties()[indices.graphics_family.value()].timestampValidBits;
+
+            is_supported_ = gpu.get_properties().limits.timestampComputeAndGraphics == VK_TRUE && valid_bits != 0;
+            valid_mask_ = (valid_bits >= 64) ? ~0ULL : ((1ULL << valid_bits) - 1);
+            timestamp_period_ = gpu.get_properties().limits.timestampPeriod;
+        }
+        else if (type_ == VK_QUERY_TYPE_PIPELINE_STATISTICS)
+        {
+            is_supported_ = gpu.get_features().pipelineStatisticsQuery == VK_TRUE;
+            result_count_ = 0;
+            for (VkQueryPipelineStatisticFlags flags = statistics_; flags != 0; flags &= flags - 1)
+            {
+                result_count_++;
+            }
+        }
+        else
+        {
+            is_supported_ = true;
+        }
+        if (!is_supported_)
+        {
+            return;
+        }
+
+        VkQueryPoolCreateInfo query_pool_info{};
+        query_pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        query_pool_info.queryType = type_;
+        query_pool_info.queryCount = count_;
+        query_pool_info.pipelineStatistics = statistics_;
+
+        if (vkCreateQueryPool(*device_, &query_pool_info, nullptr, &handle_) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create query pool!");
+        }
+    }
+
+    QueryPool::~QueryPool()
+    {
+        destroy();
+    }
+
+    void QueryPool::reset(VkCommandBuffer command_buffer, uint32_t first_query, uint32_t query_count) const
+    {
+        if (is_supported_)
+        {
+            vkCmdResetQueryPool(command_buffer, handle_, first_query, query_count);
+        }
+    }
+
+    void QueryPool::write_timestamp(VkCommandBuffer command_buffer, VkPipelineStageFlagBits stage, uint32_t query) const
+    {
+        if (is_supported_)
+        {
+            vkCmdWriteTimestamp(command_buffer, stage, handle_, query);
+        }
+    }
+
+    void QueryPool::begin(VkCommandBuffer command_buffer, uint32_t query) const
+    {
+        if (is_supported_)
+        {
+            vkCmdBeginQuery(command_buffer, handle_, query, 0);
+        }
+    }
+
+    void QueryPool::end(VkCommandBuffer command_buffer, uint32_t query) const
+    {
+        if (is_supported_)
+        {
+            vkCmdEndQuery(command_buffer, handle_, query);
+        }
+    }
+
+    bool QueryPool::get_results(uint32_t first_query, uint32_t query_count, std::vector<uint64_t> &results) const
+    {
+        if (!is_supported_)
+        {
+            return false;
+        }
+        results.resize(query_count * result_count_);
+        VkResult result = vkGetQueryPoolResults(*device_,
+                                                handle_,
+                                                first_query,
+                                                query_count,
+                                                results.size() * sizeof(uint64_t),
+                                                results.data(),
+                                                result_count_ * sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS)
+        {
+            return false;
+        }
+        if (type_ == VK_QUERY_TYPE_TIMESTAMP)
+        {
+            for (auto &value : results)
+            {
+                value &= valid_mask_;
+            }
+        }
+        return true;
+    }
+
+    double QueryPool::get_elapsed_ms(uint32_t begin_query) const
+    {
+        std::vector<uint64_t> timestamps;
+        if (type_ != VK_QUERY_TYPE_TIMESTAMP || !get_results(begin_query, 2, timestamps))
+        {
+            return -1.0;
+        }
+        uint64_t ticks = (timestamps[1] - timestamps[0]) & valid_mask_;
+        return static_cast<double>(ticks) * timestamp_period_ / 1000000.0;
+    }
+
+    void QueryPool::destroy()
+    {
+        if (handle_ != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(*device_, handle_, nullptr);
+            handle_ = VK_NULL_HANDLE;
+        }
+    }
+} // namespace vkcpp
@@ -0,0 +1,75 @@
+#ifndef VKCPP_RENDER_COMMAND_QUERY_POOL_H
+#define VKCPP_RENDER_COMMAND_QUERY_POOL_H
+
+#include "vulkan_header.h"
+
+namespace vkcpp
+{
+    class Device;
+
+    /**
+     *  A wrapper class for VkQueryPool (timestamp or pipeline statistics)
+     *  If the gpu does not support the query type, every command is a no-op and get_results returns false.
+     */
+    class QueryPool
+    {
+    private:
+        const Device *device_{nullptr};
+
+        VkQueryType type_{VK_QUERY_TYPE_TIMESTAMP};
+
+        uint32_t count_{0};
+
+        VkQueryPipelineStatisticFlags statistics_{0};
+
+        // values per query
+        uint32_t result_count_{1};
+
+        bool is_supported_{false};
+
+        uint64_t valid_mask_{~0ULL};
+
+        // nanoseconds per timestamp tick
+        float timestamp_period_{1.0f};
+
+        VkQueryPool handle_{VK_NULL_HANDLE};
+
+    public:
+        QueryPool(const Device *device, VkQueryType type, uint32_t count, VkQueryPipelineStatisticFlags statistics = 0);
+
+        QueryPool(const QueryPool &) = delete;
+
+        ~QueryPool();
+
+        operator const VkQueryPool &() const { return handle_; }
+
+        const bool is_supported() const { return is_supported_; }
+
+        const uint32_t get_result_count() const { return result_count_; }
+
+        /**
+         *  must be recorded outside of a render pass
+         */
+        void reset(VkCommandBuffer command_buffer, uint32_t first_query, uint32_t query_count) const;
+
+        void write_timestamp(VkCommandBuffer command_buffer, VkPipelineStageFlagBits stage, uint32_t query) const;
+
+        void begin(VkCommandBuffer command_buffer, uint32_t query) const;
+
+        void end(VkCommandBuffer command_buffer, uint32_t query) const;
+
+        /**
+         *  @brief without waiting, false if the results are not available yet
+         */
+        bool get_results(uint32_t first_query, uint32_t query_count, std::vector<uint64_t> &results) const;
+
+        /**
+         *  @return milliseconds between timestamp begin_query and begin_query + 1, negative if not available
+         */
+        double get_elapsed_ms(uint32_t begin_query) const;
+
+        void destroy();
+    }; // class QueryPool
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_RENDER_COMMAND_QUERY_POOL_H
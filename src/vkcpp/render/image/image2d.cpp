@@ -225,6 +225,12 @@ namespace vkcpp
             throw std::runtime_error("failed to load texture image!");
         }
 
+        sub_texture_pixels(pixels, image_size);
+        stbi_image_free(pixels);
+    }
+
+    void Image2D::sub_texture_pixels(const void *pixels, VkDeviceSize image_size)
+    {
         VkBuffer staging_buffer;
         VkDeviceMemory staging_memory;
         create::buffer(
@@ -240,8 +246,6 @@ namespace vkcpp
         memcpy(data, pixels, static_cast<size_t>(image_size));
         vkUnmapMemory(*device_, staging_memory);
 
-        stbi_image_free(pixels);
-
         CommandBuffers cmd_buffer = std::move(CommandBuffers::beginSingleTimeCmd(device_, command_pool_));
 
         CommandBuffers::cmdImageMemoryBarrier(
@@ -259,8 +263,8 @@ namespace vkcpp
             cmd_buffer[0],
             staging_buffer,
             image_,
-            static_cast<uint32_t>(tex_width_),
-            static_cast<uint32_t>(tex_height_));
+            extent_.width,
+            extent_.height);
 
         CommandBuffers::cmdImageMemoryBarrier(
             cmd_buffer[0],
@@ -47,6 +47,11 @@ namespace vkcpp
          * Maybe problem : read and write at the same time
          */
         void sub_texture_image(const char *filename);
+
+        /**
+         *  @brief tightly packed pixels of the image extent and format -> texture
+         */
+        void sub_texture_pixels(const void *pixels, VkDeviceSize size);
     };
 
 } // namespace vkcpp
@@ -0,0 +1,163 @@
+#include "image_atlas.h"
+
+#include "device/device.h"
+#include "device/physical_device.h"
+#include "render/command/command_buffers.h"
+
+#include "utility/create.h"
+
+namespace vkcpp
+{
+    ImageAtlas::ImageAtlas(const Device *device,
+                           const CommandPool *command_pool,
+                           const std::vector<const char *> &filenames,
+                           VkFormat format,
+                           VkFilter filter,
+                           VkSamplerAddressMode address_mode)
+        : Image2D(device, command_pool, VkExtent3D{0, 0, 1}, format, filter, address_mode, true, false, false),
+          filenames_(filenames)
+    {
+        init_image_atlas();
+        init_image_view();
+        init_sampler(VK_TRUE, 0);
+    }
+
+    void ImageAtlas::init_image_atlas()
+    {
+        if (format_ != VK_FORMAT_R8G8B8A8_SRGB)
+        {
+            throw std::runtime_error("failed to create atlas! only RGBA");
+        }
+        int size = static_cast<int>(filenames_.size());
+        std::vector<stbi_uc *> pixels(size, nullptr);
+        std::vector<std::pair<uint32_t, uint32_t>> offsets(size);
+        regions_.resize(size);
+
+        // pack : top to bottom, next column when the max dimension is reached
+        const uint32_t max_dim = device_->get_gpu().get_properties().limits.maxImageDimension2D;
+        uint32_t x = 0, y = 0, column_width = 0;
+        uint32_t atlas_width = 0, atlas_height = 0;
+        for (int i = 0; i < size; i++)
+        {
+            int width, height, channels;
+            pixels[i] = stbi_load(filenames_[i], &width, &height, &channels, STBI_rgb_alpha);
+            if (pixels[i] == nullptr)
+            {
+                for (auto &p : pixels)
+                {
+                    stbi_image_free(p);
+                }
+                throw std::runtime_error("failed to load texture image!");
+            }
+            regions_[i].width = static_cast<uint32_t>(width);
+            regions_[i].height = static_cast<uint32_t>(height);
+
+            if (y > 0 && y + regions_[i].height > max_dim)
+            {
+                x += column_width + PADDING_;
+                y = 0;
+                column_width = 0;
+            }
+            offsets[i] = {x, y};
+            y += regions_[i].height + PADDING_;
+            column_width = std::max(column_width, regions_[i].width);
+            atlas_width = std::max(atlas_width, x + regions_[i].width);
+            atlas_height = std::max(atlas_height, y - PADDING_);
+        }
+        if (atlas_width > max_dim || atlas_height > max_dim)
+        {
+            for (auto &p : pixels)
+            {
+                stbi_image_free(p);
+            }
+            throw std::runtime_error("failed to create atlas! too large");
+        }
+        extent_ = {atlas_width, atlas_height, 1U};
+
+        for (int i = 0; i < size; i++)
+        {
+            // half texel inset : no bleeding from the neighbour with linear filter
+            regions_[i].u0 = (offsets[i].first + 0.5f) / atlas_width;
+            regions_[i].v0 = (offsets[i].second + 0.5f) / atlas_height;
+            regions_[i].u1 = (offsets[i].first + regions_[i].width - 0.5f) / atlas_width;
+            regions_[i].v1 = (offsets[i].second + regions_[i].height - 0.5f) / atlas_height;
+        }
+
+        VkDeviceSize image_size = extent_.width * extent_.height * 4;
+
+        VkBuffer staging_buffer;
+        VkDeviceMemory staging_memory;
+        create::buffer(
+            device_,
+            image_size,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            staging_buffer,
+            staging_memory);
+
+        char *data;
+        vkMapMemory(*device_, staging_memory, 0, image_size, 0, (void **)&data);
+        // transparent padding
+        memset(data, 0, static_cast<size_t>(image_size));
+        for (int i = 0; i < size; i++)
+        {
+            size_t row_size = regions_[i].width * 4;
+            for (uint32_t row = 0; row < regions_[i].height; row++)
+            {
+                memcpy(data + (static_cast<size_t>(offsets[i].second + row) * extent_.width + offsets[i].first) * 4,
+                       pixels[i] + row * row_size,
+                       row_size);
+            }
+            stbi_image_free(pixels[i]);
+        }
+        vkUnmapMemory(*device_, staging_memory);
+
+        create::image(
+            device_,
+            VK_IMAGE_TYPE_2D,
+            format_,
+            extent_,
+            VK_IMAGE_TILING_OPTIMAL,
+            samples_,
+            usage_,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            image_,
+            memory_);
+
+        CommandBuffers cmd_buffer = std::move(CommandBuffers::beginSingleTimeCmd(device_, command_pool_));
+
+        CommandBuffers::cmdImageMemoryBarrier(
+            cmd_buffer[0],
+            image_,
+            0,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+        CommandBuffers::cmdCopyBufferToImage(
+            cmd_buffer[0],
+            staging_buffer,
+            image_,
+            extent_.width,
+            extent_.height);
+
+        CommandBuffers::cmdImageMemoryBarrier(
+            cmd_buffer[0],
+            image_,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            layout_,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+        CommandBuffers::endSingleTimeCmd(cmd_buffer);
+
+        vkDestroyBuffer(*device_, staging_buffer, nullptr);
+        vkFreeMemory(*device_, staging_memory, nullptr);
+    }
+} // namespace vkcpp
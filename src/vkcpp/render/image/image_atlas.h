@@ -0,0 +1,51 @@
+#ifndef VKCPP_RENDER_IMAGE_IMAGE_ATLAS_H
+#define VKCPP_RENDER_IMAGE_IMAGE_ATLAS_H
+
+#include "image2d.h"
+
+namespace vkcpp
+{
+    struct AtlasRegion
+    {
+        // normalized texture coordinate
+        float u0{0.0f};
+        float v0{0.0f};
+        float u1{1.0f};
+        float v1{1.0f};
+        // source image size
+        uint32_t width{0};
+        uint32_t height{0};
+    };
+
+    /**
+     *  Several textures packed into one VkImage (column shelves, transparent padding).
+     *  Objects select a texture by region, so one descriptor set and pipeline serve all of them.
+     */
+    class ImageAtlas : public Image2D
+    {
+    private:
+        static constexpr uint32_t PADDING_ = 2;
+
+        std::vector<const char *> filenames_;
+
+        std::vector<AtlasRegion> regions_;
+
+    public:
+        explicit ImageAtlas(const Device *device,
+                            const CommandPool *command_pool,
+                            const std::vector<const char *> &filenames,
+                            VkFormat format = VK_FORMAT_R8G8B8A8_SRGB,
+                            VkFilter filter = VK_FILTER_LINEAR,
+                            VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+
+        virtual ~ImageAtlas() = default;
+
+        const std::vector<AtlasRegion> &get_regions() const { return regions_; }
+
+        const int get_region_count() const { return static_cast<int>(regions_.size()); }
+
+        void init_image_atlas();
+    }; // class ImageAtlas
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_RENDER_IMAGE_IMAGE_ATLAS_H
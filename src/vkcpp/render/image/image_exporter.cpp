@@ -0,0 +1,105 @@
+#include "image_exporter.h"
+
+#include "device/device.h"
+#include "render/command/command_buffers.h"
+#include "utility/create.h"
+#include "utility/image_encoder.h"
+#include "utility/trace.h"
+
+namespace vkcpp
+{
+    ImageExporter::ImageExporter(const Device *device, const CommandPool *command_pool, const VkExtent3D &extent, VkFormat format, uint32_t slot_count)
+        : device_(device), command_pool_(command_pool), extent_(extent), format_(format), slots_(std::max(slot_count, 1u))
+    {
+        VkDeviceSize size = extent_.width * extent_.height * 4;
+        for (auto &slot : slots_)
+        {
+            create::buffer(
+                device_,
+                size,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+                slot.buffer,
+                slot.memory);
+            vkMapMemory(*device_, slot.memory, 0, VK_WHOLE_SIZE, 0, (void **)&slot.data);
+        }
+    }
+
+    ImageExporter::~ImageExporter()
+    {
+        wait();
+        for (auto &slot : slots_)
+        {
+            vkUnmapMemory(*device_, slot.memory);
+            vkFreeMemory(*device_, slot.memory, nullptr);
+            vkDestroyBuffer(*device_, slot.buffer, nullptr);
+        }
+    }
+
+    void ImageExporter::snapshot(VkImage image, VkImageLayout layout, const std::string &filename)
+    {
+        VKCPP_TRACE_SCOPE("ImageExporter::snapshot");
+        Slot &slot = slots_[slot_idx_];
+        slot_idx_ = (slot_idx_ + 1) % slots_.size();
+        if (slot.thread.joinable())
+        {
+            slot.thread.join();
+        }
+
+        VkDeviceSize size = extent_.width * extent_.height * 4;
+        CommandBuffers copy_cmd = std::move(CommandBuffers::beginSingleTimeCmd(device_, command_pool_));
+        CommandBuffers::cmdImageMemoryBarrier(
+            copy_cmd[0],
+            image,
+            VK_ACCESS_MEMORY_READ_BIT,
+            VK_ACCESS_TRANSFER_READ_BIT,
+            layout,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+        CommandBuffers::cmdCopyImageToBuffer(copy_cmd[0], slot.buffer, image, {0, 0, 0}, extent_);
+
+        CommandBuffers::cmdBufferMemoryBarrier(
+            copy_cmd[0],
+            slot.buffer,
+            0,
+            size,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_HOST_READ_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT);
+
+        CommandBuffers::cmdImageMemoryBarrier(
+            copy_cmd[0],
+            image,
+            VK_ACCESS_TRANSFER_READ_BIT,
+            VK_ACCESS_MEMORY_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            layout,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+        copy_cmd.flush_command_buffer(0);
+
+        slot.thread = std::thread([data = slot.data, extent = extent_, format = format_, filename]()
+                                  {
+                                      if (!encode::file(filename, data, extent, extent.width * 4, format))
+                                      {
+                                          std::cerr << "failed to write image: " << filename << "\n";
+                                      } });
+    }
+
+    void ImageExporter::wait()
+    {
+        for (auto &slot : slots_)
+        {
+            if (slot.thread.joinable())
+            {
+                slot.thread.join();
+            }
+        }
+    }
+} // namespace vkcpp
@@ -0,0 +1,64 @@
+#ifndef VKCPP_RENDER_IMAGE_IMAGE_EXPORTER_H
+#define VKCPP_RENDER_IMAGE_IMAGE_EXPORTER_H
+
+#include "vulkan_header.h"
+
+namespace vkcpp
+{
+    class Device;
+
+    class CommandPool;
+
+    /**
+     *  Snapshots of an image to png, qoi or ppm (by file extension).
+     *  The readback buffers stay mapped, the copy is the only gpu wait of the caller:
+     *  swizzle, encode and write run on the thread of the slot.
+     */
+    class ImageExporter
+    {
+    private:
+        struct Slot
+        {
+            VkBuffer buffer{VK_NULL_HANDLE};
+            VkDeviceMemory memory{VK_NULL_HANDLE};
+            const char *data{nullptr};
+            std::thread thread;
+        };
+
+        const Device *device_{nullptr};
+
+        const CommandPool *command_pool_{nullptr};
+
+        VkExtent3D extent_{};
+
+        VkFormat format_{VK_FORMAT_R8G8B8A8_SRGB};
+
+        // a snapshot waits only for the encode of the slot it reuses
+        std::vector<Slot> slots_;
+
+        uint32_t slot_idx_{0};
+
+    public:
+        /**
+         *  @param extent, format : of the exported images (8 bit, 4 channels)
+         *  @param slot_count snapshots encoded at the same time
+         */
+        ImageExporter(const Device *device, const CommandPool *command_pool, const VkExtent3D &extent, VkFormat format, uint32_t slot_count = 2);
+
+        ImageExporter(const ImageExporter &) = delete;
+
+        ~ImageExporter();
+
+        /**
+         *  @param layout of image, restored after the copy
+         */
+        void snapshot(VkImage image, VkImageLayout layout, const std::string &filename);
+
+        /**
+         *  @brief wait for every pending encode
+         */
+        void wait();
+    }; // class ImageExporter
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_RENDER_IMAGE_IMAGE_EXPORTER_H
@@ -4,8 +4,11 @@
 #include "device/physical_device.h"
 #include "render/command/command_buffers.h"
 #include "render/command/command_pool.h"
+#include "render/command/query_pool.h"
 
 #include "utility/create.h"
+#include "utility/profiler.h"
+#include "utility/trace.h"
 namespace vkcpp
 {
     Offscreen::Offscreen(const Device *device,
@@ -17,7 +20,7 @@ namespace vkcpp
                                                                 VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
                                                                 samples,
                                                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                                                                VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                                                VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                                                                 VK_FORMAT_R8G8B8A8_SRGB,
                                                                 1, 1, extent)
     {
@@ -26,6 +29,7 @@ namespace vkcpp
         command_pool_ = uniq_command_pool_.get();
 
         image_size_ = extent.width * extent.height * 4;
+        timestamps_ = std::make_unique<QueryPool>(device_, VK_QUERY_TYPE_TIMESTAMP, 4);
 
         create::image(
             device_,
@@ -58,19 +62,21 @@ namespace vkcpp
     }
     Offscreen::~Offscreen()
     {
-        vkQueueWaitIdle(*device_->get_graphics_queue());
+        device_->graphics_queue_wait_idle();
         if (is_mapping)
         {
             unmap_memory();
         }
         vkDestroyBuffer(*device_, staging_buffer_, nullptr);
         vkFreeMemory(*device_, staging_memory_, nullptr);
+        timestamps_.reset();
         uniq_command_pool_.reset();
     }
 
     //TODO : fix hard coding "supportsBlit = false"
     const char *Offscreen::map_image_memory()
     {
+        VKCPP_TRACE_SCOPE("Offscreen::map_image_memory");
         if (is_mapping)
         {
             unmap_memory();
@@ -84,6 +90,8 @@ namespace vkcpp
 
         // Do the actual blit from the swapchain image to our host visible destination image
         vkcpp::CommandBuffers copy_cmd = std::move(vkcpp::CommandBuffers::beginSingleTimeCmd(device, command_pool_));
+        timestamps_->reset(copy_cmd[0], 0, 2);
+        timestamps_->write_timestamp(copy_cmd[0], VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0);
 
         // Transition destination image to transfer destination layout
         vkcpp::CommandBuffers::cmdBufferMemoryBarrier(
@@ -133,8 +141,13 @@ namespace vkcpp
             VK_PIPELINE_STAGE_TRANSFER_BIT,
             VK_PIPELINE_STAGE_TRANSFER_BIT, //VK_PIPELINE_STAGE_TRANSFER_BIT,
             {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+        timestamps_->write_timestamp(copy_cmd[0], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 1);
 
         copy_cmd.flush_command_buffer(0);
+        if (Profiler::getInstance()->is_enabled())
+        {
+            Profiler::getInstance()->add_gpu(profile_owner_, "readback", timestamps_->get_elapsed_ms(0));
+        }
 
         // Map image memory so we can start copying from it
         const char *data;
@@ -146,6 +159,54 @@ namespace vkcpp
         vkUnmapMemory(*device_, staging_memory_);
         is_mapping = false;
     }
+    void Offscreen::cmd_restore(VkCommandBuffer command_buffer, VkImage src_image, const VkRect2D &region)
+    {
+        vkcpp::CommandBuffers::cmdImageMemoryBarrier(
+            command_buffer,
+            src_image,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_ACCESS_TRANSFER_READ_BIT,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+        // previous contents are overwritten
+        vkcpp::CommandBuffers::cmdImageMemoryBarrier(
+            command_buffer,
+            image_,
+            VK_ACCESS_TRANSFER_READ_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+        // same format : copy without blit
+        vkcpp::CommandBuffers::cmdCopyImage(
+            command_buffer,
+            false,
+            {region.extent.width, region.extent.height, 1},
+            {region.offset.x, region.offset.y, 0},
+            {region.offset.x, region.offset.y, 0},
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+            src_image, image_);
+
+        vkcpp::CommandBuffers::cmdImageMemoryBarrier(
+            command_buffer,
+            src_image,
+            VK_ACCESS_TRANSFER_READ_BIT,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+    }
+
     void Offscreen::screen_to_image(const CommandPool *command_pool, VkImage host_dst_image, const VkExtent3D &src_extent, const VkOffset3D &src_offset, const VkFormat &color_format)
     {
         if (!(extent_.width >= src_offset.x + src_extent.width && extent_.height >= src_offset.y + src_extent.height))
@@ -156,15 +217,17 @@ namespace vkcpp
 
         // Do the actual blit from the swapchain image to our host visible destination image
         vkcpp::CommandBuffers copy_cmd = std::move(vkcpp::CommandBuffers::beginSingleTimeCmd(device_, command_pool));
-        // Transition destination image to transfer destination layout
+        timestamps_->reset(copy_cmd[0], 2, 2);
+        timestamps_->write_timestamp(copy_cmd[0], VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 2);
+        // Transition destination image to transfer destination layout (keep the contents outside the region)
         vkcpp::CommandBuffers::cmdImageMemoryBarrier(
             copy_cmd[0],
             host_dst_image,
-            0,
+            VK_ACCESS_SHADER_READ_BIT,
             VK_ACCESS_TRANSFER_WRITE_BIT,
-            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
             VK_PIPELINE_STAGE_TRANSFER_BIT,
             VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
 
@@ -183,7 +246,7 @@ namespace vkcpp
         vkcpp::CommandBuffers::cmdCopyImage(
             copy_cmd[0],
             supportsBlit,
-            extent_,
+            src_extent,
             src_offset,
             src_offset,
             {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
@@ -213,8 +276,13 @@ namespace vkcpp
             VK_PIPELINE_STAGE_TRANSFER_BIT,
             VK_PIPELINE_STAGE_TRANSFER_BIT,
             {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+        timestamps_->write_timestamp(copy_cmd[0], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 3);
 
         copy_cmd.flush_command_buffer(0);
+        if (Profiler::getInstance()->is_enabled())
+        {
+            Profiler::getInstance()->add_gpu(profile_owner_, "copy", timestamps_->get_elapsed_ms(2));
+        }
     }
 
 } // namespace vkcpp
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 namespace vkcpp
 {
+    class QueryPool;
+
     class Offscreen : public Image
     {
     private:
@@ -16,10 +18,18 @@ namespace vkcpp
 
         bool is_mapping{false};
 
+        // timestamps : [0, 1] readback, [2, 3] copy to image
+        std::unique_ptr<QueryPool> timestamps_{nullptr};
+
+        // Profiler owner of the gpu times
+        uint32_t profile_owner_{0};
+
     public:
         explicit Offscreen(const Device *device, const CommandPool *command_pool, const VkExtent3D &extent, VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
 
         virtual ~Offscreen();
+
+        void set_profile_owner(uint32_t owner) { profile_owner_ = owner; }
         void init_offscreen_image();
 
         void init_offscreen_view();
@@ -27,6 +37,12 @@ namespace vkcpp
         std::unique_ptr<CommandPool> uniq_command_pool_;
 
         void unmap_memory();
+        /**
+         *  @brief record : region of src_image (SHADER_READ_ONLY_OPTIMAL, same extent and format) -> this image
+         *  this image is left in TRANSFER_DST_OPTIMAL for a LOAD render pass, outside the region is undefined
+         */
+        void cmd_restore(VkCommandBuffer command_buffer, VkImage src_image, const VkRect2D &region);
+
         void screen_to_image(const CommandPool *command_pool, VkImage host_dst_image, const VkExtent3D &src_extent, const VkOffset3D &src_offset, const VkFormat &color_format);
     };
 
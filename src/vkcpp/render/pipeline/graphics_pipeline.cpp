@@ -6,7 +6,6 @@
 #include "render/swapchain/render_pass.h"
 #include "object/shader_attribute.hpp"
 #include "render/buffer/descriptor_sets.h"
-#include "utility/create.h"
 
 namespace vkcpp
 {
@@ -41,6 +40,24 @@ namespace vkcpp
         destroy();
     }
 
+    VkPipelineColorBlendAttachmentState GraphicsPipeline::getColorBlendAttachmentState()
+    {
+        VkPipelineColorBlendAttachmentState color_blend_attachment{};
+
+        color_blend_attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        color_blend_attachment.blendEnable = VK_TRUE;
+        //Straight alpha : finalColor.rgb = src.a * src.rgb + (1 - src.a) * dst.rgb;
+        color_blend_attachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        color_blend_attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        color_blend_attachment.colorBlendOp = VK_BLEND_OP_ADD;
+        // finalColor.a = src.a
+        color_blend_attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; //VK_BLEND_FACTOR_SRC_ALPHA;
+        color_blend_attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;  //VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        color_blend_attachment.alphaBlendOp = VK_BLEND_OP_ADD;
+
+        return color_blend_attachment;
+    }
+
     void GraphicsPipeline::init_input_assembly_state_create_info()
     {
         VkPipelineInputAssemblyStateCreateInfo &input_assembly = info_.input_assembly_state;
@@ -113,22 +130,22 @@ namespace vkcpp
 
     void GraphicsPipeline::init_pipeline()
     {
-        // Shader Stages
-        vert_shader_module_ = create::shaderModule(device_, vert_shader_file_);
-        frag_shader_module_ = create::shaderModule(device_, frag_shader_file_);
+        // Shader Stages : shared with other pipelines through the registry
+        vert_shader_module_ = device_->get_pipeline_registry()->get_shader_module(vert_shader_file_);
+        frag_shader_module_ = device_->get_pipeline_registry()->get_shader_module(frag_shader_file_);
 
         VkPipelineShaderStageCreateInfo vert_shader_stage_create_info{};
 
         vert_shader_stage_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
         vert_shader_stage_create_info.stage = VK_SHADER_STAGE_VERTEX_BIT;
-        vert_shader_stage_create_info.module = vert_shader_module_;
+        vert_shader_stage_create_info.module = vert_shader_module_.get();
         vert_shader_stage_create_info.pName = "main";
 
         VkPipelineShaderStageCreateInfo frag_shader_stage_create_info{};
 
         frag_shader_stage_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
         frag_shader_stage_create_info.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-        frag_shader_stage_create_info.module = frag_shader_module_;
+        frag_shader_stage_create_info.module = frag_shader_module_.get();
         frag_shader_stage_create_info.pName = "main";
         info_.shader_stages = {vert_shader_stage_create_info, frag_shader_stage_create_info};
 
@@ -146,18 +163,7 @@ namespace vkcpp
         vertex_input_info.pVertexAttributeDescriptions = attributeDescriptions.data();
 
         // ColorBlendAttachment
-        VkPipelineColorBlendAttachmentState color_blend_attachment{};
-
-        color_blend_attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        color_blend_attachment.blendEnable = VK_TRUE;
-        //Straight alpha : finalColor.rgb = src.a * src.rgb + (1 - src.a) * dst.rgb;
-        color_blend_attachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-        color_blend_attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-        color_blend_attachment.colorBlendOp = VK_BLEND_OP_ADD;
-        // finalColor.a = src.a
-        color_blend_attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; //VK_BLEND_FACTOR_SRC_ALPHA;
-        color_blend_attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;  //VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-        color_blend_attachment.alphaBlendOp = VK_BLEND_OP_ADD;
+        VkPipelineColorBlendAttachmentState color_blend_attachment = getColorBlendAttachmentState();
 
         VkPipelineColorBlendStateCreateInfo &color_blending = info_.color_blend_state;
 
@@ -210,8 +216,6 @@ namespace vkcpp
         {
             throw std::runtime_error("failed to create graphics pipeline!");
         }
-        vkDestroyShaderModule(*device_, vert_shader_module_, nullptr);
-        vkDestroyShaderModule(*device_, frag_shader_module_, nullptr);
     }
 
     void GraphicsPipeline::destroy()
@@ -227,5 +231,7 @@ namespace vkcpp
             vkDestroyPipelineLayout(*device_, layout_, nullptr);
             layout_ = VK_NULL_HANDLE;
         }
+        vert_shader_module_ = nullptr;
+        frag_shader_module_ = nullptr;
     }
 } // namespace vkcpp
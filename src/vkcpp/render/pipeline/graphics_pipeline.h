@@ -3,6 +3,7 @@
 
 #include "vulkan_header.h"
 #include "pipeline.hpp"
+#include "pipeline_registry.h"
 
 namespace vkcpp
 {
@@ -33,9 +34,9 @@ namespace vkcpp
 
         VkPipelineLayout layout_{VK_NULL_HANDLE};
 
-        VkShaderModule vert_shader_module_{VK_NULL_HANDLE};
+        PipelineRegistry::ShaderModule vert_shader_module_{nullptr};
 
-        VkShaderModule frag_shader_module_{VK_NULL_HANDLE};
+        PipelineRegistry::ShaderModule frag_shader_module_{nullptr};
 
         VkPipeline handle_{VK_NULL_HANDLE};
 
@@ -65,6 +66,11 @@ namespace vkcpp
             return pipeline_bind_point_;
         }
 
+        /**
+         *  @brief straight alpha, shared by init_pipeline and the registry key
+         */
+        static VkPipelineColorBlendAttachmentState getColorBlendAttachmentState();
+
         /**
          *  @brief create vert and frag shader module, stage create info.
          *  @return vector of vert and frag stage create info
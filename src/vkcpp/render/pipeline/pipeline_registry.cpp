@@ -0,0 +1,222 @@
+#include "pipeline_registry.h"
+
+#include "graphics_pipeline.h"
+#include "device/device.h"
+#include "render/render_stage.h"
+#include "render/buffer/descriptor_sets.h"
+#include "object/shader_attribute.hpp"
+#include "utility/create.h"
+
+namespace vkcpp
+{
+    template <typename T>
+    static void hashCombine(size_t &seed, const T &value)
+    {
+        seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    static void appendBytes(std::string &bytes, const void *data, size_t size)
+    {
+        bytes.append(static_cast<const char *>(data), size);
+    }
+
+    template <typename Map>
+    static void eraseExpired(Map &map)
+    {
+        for (auto it = map.begin(); it != map.end();)
+        {
+            it = it->second.expired() ? map.erase(it) : std::next(it);
+        }
+    }
+
+    bool DescriptorSetLayoutKey::operator==(const DescriptorSetLayoutKey &other) const
+    {
+        return std::equal(bindings.begin(), bindings.end(), other.bindings.begin(), other.bindings.end(),
+                          [](const VkDescriptorSetLayoutBinding &a, const VkDescriptorSetLayoutBinding &b)
+                          {
+                              return a.binding == b.binding &&
+                                     a.descriptorType == b.descriptorType &&
+                                     a.descriptorCount == b.descriptorCount &&
+                                     a.stageFlags == b.stageFlags &&
+                                     a.pImmutableSamplers == b.pImmutableSamplers;
+                          });
+    }
+
+    size_t DescriptorSetLayoutKey::Hash::operator()(const DescriptorSetLayoutKey &key) const
+    {
+        size_t seed = 0;
+        for (auto &binding : key.bindings)
+        {
+            hashCombine(seed, binding.binding);
+            hashCombine(seed, static_cast<int>(binding.descriptorType));
+            hashCombine(seed, binding.descriptorCount);
+            hashCombine(seed, binding.stageFlags);
+        }
+        return seed;
+    }
+
+    bool GraphicsPipelineKey::operator==(const GraphicsPipelineKey &other) const
+    {
+        return vert_shader_file == other.vert_shader_file &&
+               frag_shader_file == other.frag_shader_file &&
+               color_format == other.color_format &&
+               depth_format == other.depth_format &&
+               subpass_idx == other.subpass_idx &&
+               set_layouts == other.set_layouts &&
+               fixed_state == other.fixed_state;
+    }
+
+    size_t GraphicsPipelineKey::Hash::operator()(const GraphicsPipelineKey &key) const
+    {
+        size_t seed = 0;
+        hashCombine(seed, key.vert_shader_file);
+        hashCombine(seed, key.frag_shader_file);
+        hashCombine(seed, static_cast<int>(key.color_format));
+        hashCombine(seed, static_cast<int>(key.depth_format));
+        hashCombine(seed, key.subpass_idx);
+        for (auto &layout : key.set_layouts)
+        {
+            hashCombine(seed, layout);
+        }
+        hashCombine(seed, key.fixed_state);
+        return seed;
+    }
+
+    PipelineRegistry::PipelineRegistry(const Device *device)
+        : device_(device)
+    {
+    }
+
+    PipelineRegistry::ShaderModule PipelineRegistry::get_shader_module(const std::string &filename)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = shader_modules_.find(filename);
+        if (it != shader_modules_.end())
+        {
+            if (auto shader_module = it->second.lock())
+            {
+                return shader_module;
+            }
+        }
+        eraseExpired(shader_modules_);
+        std::string file = filename;
+        const Device *device = device_;
+        ShaderModule shader_module(create::shaderModule(device_, file),
+                                   [device](VkShaderModule handle)
+                                   {
+                                       vkDestroyShaderModule(*device, handle, nullptr);
+                                   });
+        shader_modules_[filename] = shader_module;
+
+        return shader_module;
+    }
+
+    PipelineRegistry::DescriptorSetLayout PipelineRegistry::get_descriptor_set_layout(const std::vector<VkDescriptorSetLayoutBinding> &bindings)
+    {
+        DescriptorSetLayoutKey key{bindings};
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = descriptor_set_layouts_.find(key);
+        if (it != descriptor_set_layouts_.end())
+        {
+            if (auto layout = it->second.lock())
+            {
+                return layout;
+            }
+        }
+        eraseExpired(descriptor_set_layouts_);
+
+        VkDescriptorSetLayoutCreateInfo layout_info{};
+        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+        layout_info.pBindings = bindings.data();
+
+        VkDescriptorSetLayout handle;
+        if (vkCreateDescriptorSetLayout(*device_, &layout_info, nullptr, &handle) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create descriptor set layout!");
+        }
+        const Device *device = device_;
+        DescriptorSetLayout layout(handle,
+                                   [device](VkDescriptorSetLayout handle)
+                                   {
+                                       vkDestroyDescriptorSetLayout(*device, handle, nullptr);
+                                   });
+        descriptor_set_layouts_[key] = layout;
+
+        return layout;
+    }
+
+    std::shared_ptr<GraphicsPipeline> PipelineRegistry::get_graphics_pipeline(const RenderStage *render_stage,
+                                                                              const DescriptorSets *descriptor_sets,
+                                                                              std::string &vert_shader_file,
+                                                                              std::string &frag_shader_file,
+                                                                              int subpass_idx)
+    {
+        GraphicsPipelineKey key = makePipelineKey(render_stage, descriptor_sets, vert_shader_file, frag_shader_file, subpass_idx);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = graphics_pipelines_.find(key);
+            if (it != graphics_pipelines_.end())
+            {
+                if (auto pipeline = it->second.lock())
+                {
+                    return pipeline;
+                }
+            }
+            eraseExpired(graphics_pipelines_);
+        }
+        // shader modules are taken from this registry inside, so create without lock
+        auto pipeline = std::make_shared<GraphicsPipeline>(
+            device_,
+            render_stage,
+            descriptor_sets,
+            vert_shader_file,
+            frag_shader_file,
+            subpass_idx);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        // another thread may have created the same state meanwhile : keep the first one alive
+        auto [it, is_inserted] = graphics_pipelines_.try_emplace(key, pipeline);
+        if (!is_inserted)
+        {
+            if (auto existing = it->second.lock())
+            {
+                return existing;
+            }
+            it->second = pipeline;
+        }
+
+        return pipeline;
+    }
+
+    GraphicsPipelineKey PipelineRegistry::makePipelineKey(const RenderStage *render_stage,
+                                                          const DescriptorSets *descriptor_sets,
+                                                          const std::string &vert_shader_file,
+                                                          const std::string &frag_shader_file,
+                                                          int subpass_idx)
+    {
+        GraphicsPipelineKey key;
+        // shaders
+        key.vert_shader_file = vert_shader_file;
+        key.frag_shader_file = frag_shader_file;
+        // render pass compatibility
+        key.color_format = render_stage->get_color_format();
+        key.depth_format = render_stage->get_depth_format();
+        key.subpass_idx = subpass_idx;
+        // pipeline layout
+        key.set_layouts = descriptor_sets->get_layouts();
+        // blend
+        VkPipelineColorBlendAttachmentState color_blend_attachment = GraphicsPipeline::getColorBlendAttachmentState();
+        appendBytes(key.fixed_state, &color_blend_attachment, sizeof(color_blend_attachment));
+        // vertex layout
+        auto binding_description = shader::attribute::Vertex::getBindingDescription();
+        appendBytes(key.fixed_state, &binding_description, sizeof(binding_description));
+        auto attribute_descriptions = shader::attribute::Vertex::getAttributeDescriptions();
+        appendBytes(key.fixed_state, attribute_descriptions.data(), sizeof(attribute_descriptions));
+
+        return key;
+    }
+} // namespace vkcpp
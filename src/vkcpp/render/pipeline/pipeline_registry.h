@@ -0,0 +1,110 @@
+#ifndef VKCPP_RENDER_PIPELINE_PIPELINE_REGISTRY_H
+#define VKCPP_RENDER_PIPELINE_PIPELINE_REGISTRY_H
+
+#include "vulkan_header.h"
+
+#include <unordered_map>
+
+namespace vkcpp
+{
+    class Device;
+
+    class RenderStage;
+
+    class DescriptorSets;
+
+    class GraphicsPipeline;
+
+    /**
+     *  Full state of a descriptor set layout : the map compares keys, the hash only picks the bucket
+     */
+    struct DescriptorSetLayoutKey
+    {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+
+        bool operator==(const DescriptorSetLayoutKey &other) const;
+
+        struct Hash
+        {
+            size_t operator()(const DescriptorSetLayoutKey &key) const;
+        };
+    }; // struct DescriptorSetLayoutKey
+
+    /**
+     *  Full state of a graphics pipeline : shaders, render pass compatibility(attachment formats, subpass),
+     *  set layouts, blend and vertex layout (raw bytes)
+     */
+    struct GraphicsPipelineKey
+    {
+        std::string vert_shader_file;
+        std::string frag_shader_file;
+        VkFormat color_format{VK_FORMAT_UNDEFINED};
+        VkFormat depth_format{VK_FORMAT_UNDEFINED};
+        int subpass_idx{0};
+        std::vector<VkDescriptorSetLayout> set_layouts;
+        std::string fixed_state;
+
+        bool operator==(const GraphicsPipelineKey &other) const;
+
+        struct Hash
+        {
+            size_t operator()(const GraphicsPipelineKey &key) const;
+        };
+    }; // struct GraphicsPipelineKey
+
+    /**
+     *  Hands out shared shader modules, descriptor set layouts and graphics pipelines.
+     *  Entries are weak: the last owner destroys the vulkan handle, the registry only reuses it while alive.
+     *  Expired entries are erased when a lookup misses.
+     */
+    class PipelineRegistry
+    {
+    public:
+        using ShaderModule = std::shared_ptr<std::remove_pointer_t<VkShaderModule>>;
+
+        using DescriptorSetLayout = std::shared_ptr<std::remove_pointer_t<VkDescriptorSetLayout>>;
+
+    private:
+        const Device *device_{nullptr};
+
+        std::mutex mutex_;
+
+        std::unordered_map<std::string, std::weak_ptr<std::remove_pointer_t<VkShaderModule>>> shader_modules_;
+
+        std::unordered_map<DescriptorSetLayoutKey, std::weak_ptr<std::remove_pointer_t<VkDescriptorSetLayout>>, DescriptorSetLayoutKey::Hash> descriptor_set_layouts_;
+
+        std::unordered_map<GraphicsPipelineKey, std::weak_ptr<GraphicsPipeline>, GraphicsPipelineKey::Hash> graphics_pipelines_;
+
+    public:
+        PipelineRegistry(const Device *device);
+
+        ~PipelineRegistry() = default;
+
+        /**
+         *  @brief load spirv code once per file
+         */
+        ShaderModule get_shader_module(const std::string &filename);
+
+        /**
+         *  @brief identical bindings share one layout
+         */
+        DescriptorSetLayout get_descriptor_set_layout(const std::vector<VkDescriptorSetLayoutBinding> &bindings);
+
+        /**
+         *  @brief key = shaders, render pass compatibility(attachment formats, subpass), set layout, blend and vertex layout
+         */
+        std::shared_ptr<GraphicsPipeline> get_graphics_pipeline(const RenderStage *render_stage,
+                                                                 const DescriptorSets *descriptor_sets,
+                                                                 std::string &vert_shader_file,
+                                                                 std::string &frag_shader_file,
+                                                                 int subpass_idx);
+
+        static GraphicsPipelineKey makePipelineKey(const RenderStage *render_stage,
+                                                   const DescriptorSets *descriptor_sets,
+                                                   const std::string &vert_shader_file,
+                                                   const std::string &frag_shader_file,
+                                                   int subpass_idx);
+    }; // class PipelineRegistry
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_RENDER_PIPELINE_PIPELINE_REGISTRY_H
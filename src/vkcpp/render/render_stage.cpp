@@ -15,8 +15,8 @@ namespace vkcpp
         init_render_stage();
     }
 
-    RenderStage::RenderStage(const Device *device, const Offscreens *offscreens)
-        : device_(device), swapchain_(nullptr), offscreens_(offscreens)
+    RenderStage::RenderStage(const Device *device, const Offscreens *offscreens, VkAttachmentLoadOp color_load_op)
+        : device_(device), swapchain_(nullptr), offscreens_(offscreens), color_load_op_(color_load_op)
     {
         color_format_ = offscreens_->get_format();
         init_render_stage();
@@ -29,19 +29,27 @@ namespace vkcpp
 
     void RenderStage::init_render_stage()
     {
-        Image::getSupportedDepthFormat(device_->get_gpu(), &depth_format_);
-
         VkExtent2D extent;
         VkClearValue clear_color{};
         clear_color.color = {{0.0f, 0.0f, 0.0f, 1.0f}};
         clear_values_.emplace_back(clear_color);
-        VkClearValue clear_depth{};
-        clear_depth.depthStencil = {1.0f, 0};
-        clear_values_.emplace_back(clear_depth);
+
+        // color only offscreen : no depth format, pipelines are keyed by it
+        if (swapchain_ != nullptr || offscreens_->get_depth_size() != 0)
+        {
+            Image::getSupportedDepthFormat(device_->get_gpu(), &depth_format_);
+            VkClearValue clear_depth{};
+            clear_depth.depthStencil = {1.0f, 0};
+            clear_values_.emplace_back(clear_depth);
+        }
+        else
+        {
+            depth_format_ = VK_FORMAT_UNDEFINED;
+        }
 
         if (swapchain_ == nullptr)
         {
-            render_pass_ = std::make_unique<RenderPass>(device_, offscreens_);
+            render_pass_ = std::make_unique<RenderPass>(device_, offscreens_, color_load_op_);
             framebuffers_ = std::make_unique<Framebuffers>(device_, render_pass_.get());
             extent.width = offscreens_->get_extent().width;
             extent.height = offscreens_->get_extent().height;
@@ -70,19 +78,30 @@ namespace vkcpp
 
     void RenderStage::begin_render_pass(const VkCommandBuffer &command_buffer, int framebuffer_idx) const
     {
-        VkRect2D render_area = get_render_area();
+        begin_render_pass(command_buffer, framebuffer_idx, render_area_);
+    }
+
+    void RenderStage::begin_render_pass(const VkCommandBuffer &command_buffer, int framebuffer_idx, const VkRect2D &render_area) const
+    {
         VkViewport viewport{};
-        viewport.x = static_cast<float>(render_area.offset.x);
-        viewport.y = static_cast<float>(render_area.offset.y);
-        viewport.width = static_cast<float>(render_area.extent.width);
-        viewport.height = static_cast<float>(render_area.extent.height);
+        viewport.x = static_cast<float>(render_area_.offset.x);
+        viewport.y = static_cast<float>(render_area_.offset.y);
+        viewport.width = static_cast<float>(render_area_.extent.width);
+        viewport.height = static_cast<float>(render_area_.extent.height);
         viewport.minDepth = 0.0f;
         viewport.maxDepth = 1.0f;
         vkCmdSetViewport(command_buffer, 0, 1, &viewport);
 
+        // clamp to the full area
+        int32_t x0 = std::max(render_area.offset.x, render_area_.offset.x);
+        int32_t y0 = std::max(render_area.offset.y, render_area_.offset.y);
+        int32_t x1 = std::min(render_area.offset.x + static_cast<int32_t>(render_area.extent.width),
+                              render_area_.offset.x + static_cast<int32_t>(render_area_.extent.width));
+        int32_t y1 = std::min(render_area.offset.y + static_cast<int32_t>(render_area.extent.height),
+                              render_area_.offset.y + static_cast<int32_t>(render_area_.extent.height));
         VkRect2D scissor{};
-        scissor.offset = render_area.offset;
-        scissor.extent = render_area.extent;
+        scissor.offset = {x0, y0};
+        scissor.extent = {static_cast<uint32_t>(std::max(x1 - x0, 0)), static_cast<uint32_t>(std::max(y1 - y0, 0))};
         vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
         // Start renderpass
@@ -91,7 +110,7 @@ namespace vkcpp
         render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
         render_pass_info.renderPass = get_render_pass();
         render_pass_info.framebuffer = get_framebuffer(framebuffer_idx);
-        render_pass_info.renderArea = get_render_area();
+        render_pass_info.renderArea = scissor;
         render_pass_info.clearValueCount = clear_values_.size(); // get_clear_values().size();
         render_pass_info.pClearValues = clear_values_.data();    // get_clear_values().data();
 
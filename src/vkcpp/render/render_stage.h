@@ -33,10 +33,12 @@ namespace vkcpp
 
         VkFormat depth_format_{};
 
+        VkAttachmentLoadOp color_load_op_{VK_ATTACHMENT_LOAD_OP_CLEAR};
+
     public:
         RenderStage(const Device *deivce, const Swapchain *swapchain);
 
-        RenderStage(const Device *device, const Offscreens *offscreens);
+        RenderStage(const Device *device, const Offscreens *offscreens, VkAttachmentLoadOp color_load_op = VK_ATTACHMENT_LOAD_OP_CLEAR);
 
         virtual ~RenderStage();
 
@@ -54,12 +56,19 @@ namespace vkcpp
 
         const std::vector<VkClearValue> &get_clear_values() const { return clear_values_; }
 
+        void set_clear_color(const VkClearColorValue &color) { clear_values_[0].color = color; }
+
         void init_render_stage();
 
         void destroy();
 
         void begin_render_pass(const VkCommandBuffer &command_buffer, int framebuffer_idx) const;
 
+        /**
+         *  @param render_area render area and scissor (clamped to the full area), the viewport stays full
+         */
+        void begin_render_pass(const VkCommandBuffer &command_buffer, int framebuffer_idx, const VkRect2D &render_area) const;
+
         void end_render_pass(const VkCommandBuffer &command_buffer, int framebuffer_idx) const;
     };
 } // namespace vkcpp
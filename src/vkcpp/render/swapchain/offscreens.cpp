@@ -6,11 +6,14 @@
 namespace vkcpp
 {
 
-    Offscreens::Offscreens(const Device *device, const CommandPool *command_pool, const VkExtent3D &extent, uint32_t size)
+    Offscreens::Offscreens(const Device *device, const CommandPool *command_pool, const VkExtent3D &extent, uint32_t size, bool use_depth)
         : device_(device), command_pool_(command_pool), extent_(extent), size_(size)
     {
         init_offscreens();
-        init_depth();
+        if (use_depth)
+        {
+            init_depth();
+        }
     }
 
     Offscreens::~Offscreens()
@@ -25,6 +28,13 @@ namespace vkcpp
             offscreens_.push_back(std::make_unique<Offscreen>(device_, command_pool_, extent_));
         }
     }
+    void Offscreens::set_profile_owner(uint32_t owner)
+    {
+        for (auto &offscreen : offscreens_)
+        {
+            offscreen->set_profile_owner(owner);
+        }
+    }
     void Offscreens::init_depth()
     {
         for (uint32_t i = 0; i < size_; i++)
@@ -34,9 +44,9 @@ namespace vkcpp
     }
     void Offscreens::destroy_offscreens()
     {
-        for (uint32_t i = 0; i < size_; i++)
+        for (auto &depth : depth_)
         {
-            depth_[i].reset();
+            depth.reset();
         }
         depth_.resize(0);
         for (auto &offscreen : offscreens_)
@@ -30,7 +30,10 @@ namespace vkcpp
         std::vector<std::unique_ptr<ImageDepth>> depth_;
 
     public:
-        Offscreens(const Device *device, const CommandPool *command_pool, const VkExtent3D &extent, uint32_t size);
+        /**
+         *  @param use_depth false : color only render stage, no depth image and clear
+         */
+        Offscreens(const Device *device, const CommandPool *command_pool, const VkExtent3D &extent, uint32_t size, bool use_depth = true);
 
         ~Offscreens();
 
@@ -50,6 +53,11 @@ namespace vkcpp
 
         const VkFormat &get_format() const { return offscreens_[0]->get_format(); }
 
+        /**
+         *  @brief Profiler owner of every offscreen
+         */
+        void set_profile_owner(uint32_t owner);
+
         void init_offscreens();
 
         void init_depth();
@@ -16,8 +16,8 @@ namespace vkcpp
         init_render_pass();
     }
 
-    RenderPass::RenderPass(const Device *device, const Offscreens *offscreens)
-        : device_(device), swapchain_(nullptr), offscreens_(offscreens)
+    RenderPass::RenderPass(const Device *device, const Offscreens *offscreens, VkAttachmentLoadOp color_load_op)
+        : device_(device), swapchain_(nullptr), offscreens_(offscreens), color_load_op_(color_load_op)
     {
         // init_render_pass();
         init_render_pass_for_offscreen();
@@ -134,17 +134,19 @@ namespace vkcpp
         VkFormat color_format = offscreens_->get_format();
         VkFormat depth_format;
         Image::getSupportedDepthFormat(device_->get_gpu(), &depth_format);
+        bool use_depth = offscreens_->get_depth_size() != 0;
 
         // Create a separate render pass for the offscreen rendering as it may differ from the one used for scene rendering
         std::array<VkAttachmentDescription, 2> attchmentDescriptions = {};
         // Color attachment
         attchmentDescriptions[0].format = color_format;
         attchmentDescriptions[0].samples = VK_SAMPLE_COUNT_1_BIT;
-        attchmentDescriptions[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        attchmentDescriptions[0].loadOp = color_load_op_;
         attchmentDescriptions[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
         attchmentDescriptions[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attchmentDescriptions[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attchmentDescriptions[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        // LOAD : contents restored by a transfer before the pass
+        attchmentDescriptions[0].initialLayout = (color_load_op_ == VK_ATTACHMENT_LOAD_OP_LOAD) ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
 
         attchmentDescriptions[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
@@ -168,7 +170,7 @@ namespace vkcpp
         subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
         subpassDescription.colorAttachmentCount = 1;
         subpassDescription.pColorAttachments = &colorReference;
-        subpassDescription.pDepthStencilAttachment = &depthReference;
+        subpassDescription.pDepthStencilAttachment = use_depth ? &depthReference : nullptr;
 
         // Use subpass dependencies for layout transitions
         std::array<VkSubpassDependency, 2> dependencies;
@@ -180,6 +182,13 @@ namespace vkcpp
         dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
         dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
         dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+        if (color_load_op_ == VK_ATTACHMENT_LOAD_OP_LOAD)
+        {
+            dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            dependencies[0].dependencyFlags = 0;
+        }
 
         dependencies[1].srcSubpass = 0;
         dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
@@ -192,7 +201,8 @@ namespace vkcpp
         // Create the actual renderpass
         VkRenderPassCreateInfo renderPassInfo = {};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        renderPassInfo.attachmentCount = static_cast<uint32_t>(attchmentDescriptions.size());
+        // color only : depth description is not attached
+        renderPassInfo.attachmentCount = use_depth ? static_cast<uint32_t>(attchmentDescriptions.size()) : 1U;
         renderPassInfo.pAttachments = attchmentDescriptions.data();
         renderPassInfo.subpassCount = 1;
         renderPassInfo.pSubpasses = &subpassDescription;
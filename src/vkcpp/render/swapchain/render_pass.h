@@ -25,12 +25,15 @@ namespace vkcpp
 
         const Offscreens *offscreens_{nullptr};
 
+        // offscreen only, LOAD : the color attachment must be in TRANSFER_DST_OPTIMAL layout
+        VkAttachmentLoadOp color_load_op_{VK_ATTACHMENT_LOAD_OP_CLEAR};
+
         VkRenderPass handle_{VK_NULL_HANDLE};
 
     public:
         RenderPass(const Device *device, const Swapchain *swapchain);
 
-        RenderPass(const Device *device, const Offscreens *offscreens);
+        RenderPass(const Device *device, const Offscreens *offscreens, VkAttachmentLoadOp color_load_op = VK_ATTACHMENT_LOAD_OP_CLEAR);
 
         ~RenderPass();
 
@@ -40,6 +43,8 @@ namespace vkcpp
 
         const Swapchain *get_swapchain() const { return swapchain_; }
 
+        const VkAttachmentLoadOp get_color_load_op() const { return color_load_op_; }
+
         void init_render_pass();
 
         void init_render_pass_for_offscreen();
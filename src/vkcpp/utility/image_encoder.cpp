@@ -0,0 +1,151 @@
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "image_encoder.h"
+
+#include "stb/stb_image_write.h"
+
+namespace vkcpp
+{
+    namespace encode
+    {
+        Format formatFromFilename(const std::string &filename)
+        {
+            std::string extension = filename.substr(filename.find_last_of('.') + 1);
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            if (extension == "png")
+            {
+                return Format::PNG;
+            }
+            if (extension == "qoi")
+            {
+                return Format::QOI;
+            }
+            return Format::PPM;
+        }
+
+        void rgb(const char *src, const VkExtent3D &extent, VkDeviceSize row_pitch, bool is_bgr, std::vector<unsigned char> &dst)
+        {
+            dst.resize(static_cast<size_t>(extent.width) * extent.height * 3);
+            // channel order is fixed per image : branch free rows, the compiler vectorizes the loop
+            const int r = is_bgr ? 2 : 0;
+            const int b = is_bgr ? 0 : 2;
+            unsigned char *out = dst.data();
+            for (uint32_t y = 0; y < extent.height; y++)
+            {
+                const unsigned char *row = reinterpret_cast<const unsigned char *>(src + y * row_pitch);
+                for (uint32_t x = 0; x < extent.width; x++)
+                {
+                    out[0] = row[4 * x + r];
+                    out[1] = row[4 * x + 1];
+                    out[2] = row[4 * x + b];
+                    out += 3;
+                }
+            }
+        }
+
+        static void putBigEndian(std::vector<char> &dst, uint32_t value)
+        {
+            dst.push_back(static_cast<char>(value >> 24));
+            dst.push_back(static_cast<char>(value >> 16));
+            dst.push_back(static_cast<char>(value >> 8));
+            dst.push_back(static_cast<char>(value));
+        }
+
+        void qoi(const unsigned char *rgb, const VkExtent3D &extent, std::vector<char> &dst)
+        {
+            const uint8_t OP_INDEX = 0x00, OP_DIFF = 0x40, OP_LUMA = 0x80, OP_RUN = 0xc0, OP_RGB = 0xfe;
+            size_t pixel_count = static_cast<size_t>(extent.width) * extent.height;
+            dst.clear();
+            dst.reserve(14 + pixel_count * 4 + 8);
+            dst.insert(dst.end(), {'q', 'o', 'i', 'f'});
+            putBigEndian(dst, extent.width);
+            putBigEndian(dst, extent.height);
+            dst.push_back(3); // rgb
+            dst.push_back(0); // srgb
+
+            // alpha is always 255, an unused index entry is (0, 0, 0, 0)
+            uint8_t index[64][4] = {};
+            uint8_t prev[3] = {0, 0, 0};
+            int run = 0;
+            for (size_t i = 0; i < pixel_count; i++)
+            {
+                const uint8_t *px = rgb + i * 3;
+                if (px[0] == prev[0] && px[1] == prev[1] && px[2] == prev[2])
+                {
+                    run++;
+                    if (run == 62 || i == pixel_count - 1)
+                    {
+                        dst.push_back(static_cast<char>(OP_RUN | (run - 1)));
+                        run = 0;
+                    }
+                    continue;
+                }
+                if (run > 0)
+                {
+                    dst.push_back(static_cast<char>(OP_RUN | (run - 1)));
+                    run = 0;
+                }
+                int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + 255 * 11) % 64;
+                if (index[hash][0] == px[0] && index[hash][1] == px[1] && index[hash][2] == px[2] && index[hash][3] == 255)
+                {
+                    dst.push_back(static_cast<char>(OP_INDEX | hash));
+                }
+                else
+                {
+                    memcpy(index[hash], px, 3);
+                    index[hash][3] = 255;
+                    int8_t dr = static_cast<int8_t>(px[0] - prev[0]);
+                    int8_t dg = static_cast<int8_t>(px[1] - prev[1]);
+                    int8_t db = static_cast<int8_t>(px[2] - prev[2]);
+                    int8_t dr_dg = static_cast<int8_t>(dr - dg);
+                    int8_t db_dg = static_cast<int8_t>(db - dg);
+                    if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2)
+                    {
+                        dst.push_back(static_cast<char>(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    }
+                    else if (dr_dg > -9 && dr_dg < 8 && dg > -33 && dg < 32 && db_dg > -9 && db_dg < 8)
+                    {
+                        dst.push_back(static_cast<char>(OP_LUMA | (dg + 32)));
+                        dst.push_back(static_cast<char>((dr_dg + 8) << 4 | (db_dg + 8)));
+                    }
+                    else
+                    {
+                        dst.push_back(static_cast<char>(OP_RGB));
+                        dst.insert(dst.end(), px, px + 3);
+                    }
+                }
+                memcpy(prev, px, 3);
+            }
+            dst.insert(dst.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+        }
+
+        bool file(const std::string &filename, const char *src, const VkExtent3D &extent, VkDeviceSize row_pitch, VkFormat format)
+        {
+            bool is_bgr = (format == VK_FORMAT_B8G8R8A8_SRGB || format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SNORM);
+            std::vector<unsigned char> pixels;
+            rgb(src, extent, row_pitch, is_bgr, pixels);
+
+            Format file_format = formatFromFilename(filename);
+            if (file_format == Format::PNG)
+            {
+                return stbi_write_png(filename.c_str(), extent.width, extent.height, 3, pixels.data(), extent.width * 3) != 0;
+            }
+
+            std::vector<char> bytes;
+            if (file_format == Format::QOI)
+            {
+                qoi(pixels.data(), extent, bytes);
+            }
+            else
+            {
+                std::string header = "P6\n" + std::to_string(extent.width) + "\n" + std::to_string(extent.height) + "\n255\n";
+                bytes.reserve(header.size() + pixels.size());
+                bytes.insert(bytes.end(), header.begin(), header.end());
+                bytes.insert(bytes.end(), pixels.begin(), pixels.end());
+            }
+            std::ofstream out(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), bytes.size());
+            return static_cast<bool>(out);
+        }
+    } // namespace encode
+} // namespace vkcpp
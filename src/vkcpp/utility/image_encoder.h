@@ -0,0 +1,37 @@
+#ifndef VKCPP_UTILITY_IMAGE_ENCODER_H
+#define VKCPP_UTILITY_IMAGE_ENCODER_H
+
+#include "vulkan_header.h"
+
+namespace vkcpp
+{
+    namespace encode
+    {
+        enum class Format
+        {
+            PPM,
+            PNG,
+            QOI
+        };
+
+        /**
+         *  @return format of the file extension (.png, .qoi), PPM otherwise
+         */
+        Format formatFromFilename(const std::string &filename);
+
+        /**
+         *  @brief 8 bit rgba or bgra rows (row_pitch bytes) -> tightly packed rgb
+         */
+        void rgb(const char *src, const VkExtent3D &extent, VkDeviceSize row_pitch, bool is_bgr, std::vector<unsigned char> &dst);
+
+        void qoi(const unsigned char *rgb, const VkExtent3D &extent, std::vector<char> &dst);
+
+        /**
+         *  @brief swizzle and encode by the file extension, one write per file
+         *  @return false if the file could not be written
+         */
+        bool file(const std::string &filename, const char *src, const VkExtent3D &extent, VkDeviceSize row_pitch, VkFormat format);
+    } // namespace encode
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_UTILITY_IMAGE_ENCODER_H
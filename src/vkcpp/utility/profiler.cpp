@@ -0,0 +1,154 @@
+#include "profiler.h"
+
+namespace vkcpp
+{
+    Profiler::~Profiler()
+    {
+        close();
+    }
+
+    void Profiler::open(const std::string &filename)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        out_.open(filename, std::ios::out | std::ios::trunc);
+        if (!out_.is_open())
+        {
+            throw std::runtime_error("failed to open profile output!");
+        }
+        generations_.clear();
+        is_enabled_ = true;
+    }
+
+    void Profiler::close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        is_enabled_ = false;
+        if (out_.is_open())
+        {
+            out_.close();
+        }
+    }
+
+    void Profiler::release_owner(Owner owner)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        generations_.erase(owner);
+    }
+
+    void Profiler::add_cpu(Owner owner, const char *name, double ms)
+    {
+        if (!is_enabled_)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Entry &entry = generations_[owner].cpu[name];
+        entry.total_ms += ms;
+        entry.max_ms = std::max(entry.max_ms, ms);
+        entry.count++;
+    }
+
+    void Profiler::add_gpu(Owner owner, const char *name, double ms)
+    {
+        if (!is_enabled_ || ms < 0.0)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Entry &entry = generations_[owner].gpu[name];
+        entry.total_ms += ms;
+        entry.max_ms = std::max(entry.max_ms, ms);
+        entry.count++;
+    }
+
+    void Profiler::add_counter(Owner owner, const char *name, uint64_t value)
+    {
+        if (!is_enabled_)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        generations_[owner].counters[name] += value;
+    }
+
+    void Profiler::set_value(Owner owner, const char *name, double value)
+    {
+        if (!is_enabled_)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        generations_[owner].values[name] = value;
+    }
+
+    void Profiler::writeEntries(std::ostream &out, const std::map<std::string, Entry> &entries)
+    {
+        out << "{";
+        bool is_first = true;
+        for (auto &[name, entry] : entries)
+        {
+            if (!is_first)
+            {
+                out << ",";
+            }
+            is_first = false;
+            out << "\"" << name << "\":{\"total_ms\":" << entry.total_ms
+                << ",\"max_ms\":" << entry.max_ms
+                << ",\"count\":" << entry.count << "}";
+        }
+        out << "}";
+    }
+
+    void Profiler::end_generation(Owner owner, uint32_t strip)
+    {
+        if (!is_enabled_)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Generation &generation = generations_[owner];
+        // {"owner":1,"generation":0,"strip":0,"cpu":{...},"gpu":{...},"counters":{...},"values":{...}}
+        out_ << "{\"owner\":" << owner << ",\"generation\":" << generation.index << ",\"strip\":" << strip << ",\"cpu\":";
+        writeEntries(out_, generation.cpu);
+        out_ << ",\"gpu\":";
+        writeEntries(out_, generation.gpu);
+        out_ << ",\"counters\":{";
+        bool is_first = true;
+        for (auto &[name, value] : generation.counters)
+        {
+            if (!is_first)
+            {
+                out_ << ",";
+            }
+            is_first = false;
+            out_ << "\"" << name << "\":" << value;
+        }
+        out_ << "},\"values\":{";
+        is_first = true;
+        for (auto &[name, value] : generation.values)
+        {
+            if (!is_first)
+            {
+                out_ << ",";
+            }
+            is_first = false;
+            out_ << "\"" << name << "\":" << value;
+        }
+        out_ << "}}\n";
+        out_.flush();
+
+        generation.index++;
+        generation.cpu.clear();
+        generation.gpu.clear();
+        generation.counters.clear();
+        generation.values.clear();
+    }
+} // namespace vkcpp
@@ -0,0 +1,133 @@
+#ifndef VKCPP_UTILITY_PROFILER_H
+#define VKCPP_UTILITY_PROFILER_H
+
+#include "pattern/singleton.hpp"
+#include "stdafx.h"
+
+#include <map>
+#include <atomic>
+
+namespace vkcpp
+{
+    /**
+     *  Per generation cpu scope, gpu timestamp and counter accumulator.
+     *  Entries are kept per owner (a painting : create_owner), so concurrent jobs do not mix.
+     *  end_generation(owner) writes one json object per line (jsonl) and starts the next generation of the owner.
+     *  Disabled until open() is called: every add is a no-op.
+     */
+    class Profiler : public Singleton<Profiler>
+    {
+        // before any worker thread creates a painting (owners are created concurrently)
+        inline static const bool is_instanced_ = initInstance();
+
+    public:
+        struct Entry
+        {
+            double total_ms{0.0};
+            double max_ms{0.0};
+            uint64_t count{0};
+        };
+
+        // 0 : not owned by a painting
+        using Owner = uint32_t;
+
+    private:
+        struct Generation
+        {
+            uint64_t index{0};
+            std::map<std::string, Entry> cpu;
+            std::map<std::string, Entry> gpu;
+            std::map<std::string, uint64_t> counters;
+            std::map<std::string, double> values;
+        };
+
+        std::mutex mutex_;
+
+        std::ofstream out_;
+
+        std::atomic<bool> is_enabled_{false};
+
+        std::atomic<Owner> next_owner_{1};
+
+        std::map<Owner, Generation> generations_;
+
+        static void writeEntries(std::ostream &out, const std::map<std::string, Entry> &entries);
+
+    public:
+        Profiler() = default;
+
+        Profiler(const Profiler &) = delete;
+
+        virtual ~Profiler();
+
+        const bool is_enabled() const { return is_enabled_; }
+
+        void open(const std::string &filename);
+
+        void close();
+
+        /**
+         *  @brief new owner id, valid while the profiler lives
+         */
+        Owner create_owner() { return next_owner_++; }
+
+        /**
+         *  @brief drop the entries of the owner (not written)
+         */
+        void release_owner(Owner owner);
+
+        void add_cpu(Owner owner, const char *name, double ms);
+
+        void add_gpu(Owner owner, const char *name, double ms);
+
+        void add_counter(Owner owner, const char *name, uint64_t value);
+
+        /**
+         *  @brief last value of this generation (not accumulated)
+         */
+        void set_value(Owner owner, const char *name, double value);
+
+        /**
+         *  @param strip population index of this generation
+         */
+        void end_generation(Owner owner, uint32_t strip);
+    }; // class Profiler
+
+    /**
+     *  RAII cpu timer : adds the elapsed time of the scope to the owner in Profiler
+     */
+    class ScopeTimer
+    {
+    private:
+        const char *name_;
+
+        Profiler::Owner owner_;
+
+        bool is_enabled_;
+
+        std::chrono::high_resolution_clock::time_point begin_;
+
+    public:
+        ScopeTimer(const char *name, Profiler::Owner owner)
+            : name_(name), owner_(owner), is_enabled_(Profiler::getInstance()->is_enabled())
+        {
+            if (is_enabled_)
+            {
+                begin_ = std::chrono::high_resolution_clock::now();
+            }
+        }
+
+        ScopeTimer(const ScopeTimer &) = delete;
+
+        ~ScopeTimer()
+        {
+            if (is_enabled_)
+            {
+                auto end = std::chrono::high_resolution_clock::now();
+                Profiler::getInstance()->add_cpu(owner_, name_, std::chrono::duration<double, std::milli>(end - begin_).count());
+            }
+        }
+    }; // class ScopeTimer
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_UTILITY_PROFILER_H
@@ -0,0 +1,409 @@
+#include "timelapse_writer.h"
+
+#include <cmath>
+
+namespace vkcpp
+{
+    /**
+     *  gif lzw code stream : lsb first bits packed into sub-blocks of 255 bytes
+     */
+    class LzwWriter
+    {
+    private:
+        std::ofstream &file_;
+
+        uint32_t bits_{0};
+
+        uint32_t bit_count_{0};
+
+        std::vector<char> block_;
+
+    public:
+        explicit LzwWriter(std::ofstream &file) : file_(file) { block_.reserve(255); }
+
+        void write_code(uint32_t code, uint32_t size)
+        {
+            bits_ |= code << bit_count_;
+            bit_count_ += size;
+            while (bit_count_ >= 8)
+            {
+                put_byte(static_cast<char>(bits_ & 0xff));
+                bits_ >>= 8;
+                bit_count_ -= 8;
+            }
+        }
+
+        void put_byte(char byte)
+        {
+            block_.push_back(byte);
+            if (block_.size() == 255)
+            {
+                flush_block();
+            }
+        }
+
+        void flush_block()
+        {
+            if (!block_.empty())
+            {
+                file_.put(static_cast<char>(block_.size()));
+                file_.write(block_.data(), block_.size());
+                block_.clear();
+            }
+        }
+
+        void finish()
+        {
+            if (bit_count_ > 0)
+            {
+                put_byte(static_cast<char>(bits_ & 0xff));
+                bits_ = 0;
+                bit_count_ = 0;
+            }
+            flush_block();
+            file_.put(0); // block terminator
+        }
+    }; // class LzwWriter
+
+    static void putShort(std::ofstream &file, uint16_t value)
+    {
+        file.put(static_cast<char>(value & 0xff));
+        file.put(static_cast<char>(value >> 8));
+    }
+
+    TimelapseWriter::TimelapseWriter(const std::string &filename, const VkExtent3D &extent, uint32_t fps, const char *palette_source)
+        : extent_(extent), fps_(std::max(fps, 1u))
+    {
+        is_gif_ = filename.size() < 4 || filename.substr(filename.size() - 4) != ".y4m";
+        file_.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file_.is_open())
+        {
+            throw std::runtime_error("failed to open time-lapse file!");
+        }
+        if (!is_gif_)
+        {
+            file_ << "YUV4MPEG2 W" << extent_.width << " H" << extent_.height << " F" << fps_ << ":1 Ip A1:1 C444\n";
+            return;
+        }
+        if (palette_source != nullptr)
+        {
+            init_palette(palette_source, extent_);
+        }
+    }
+
+    TimelapseWriter::~TimelapseWriter()
+    {
+        close();
+    }
+
+    void TimelapseWriter::close()
+    {
+        if (!file_.is_open())
+        {
+            return;
+        }
+        if (is_gif_ && frame_count_ > 0)
+        {
+            file_.put(0x3b); // trailer
+        }
+        file_.close();
+    }
+
+    void TimelapseWriter::add_frame(const char *src, VkDeviceSize row_pitch, VkFormat format)
+    {
+        if (!file_.is_open())
+        {
+            return;
+        }
+        bool is_bgr = (format == VK_FORMAT_B8G8R8A8_SRGB || format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SNORM);
+        if (is_gif_)
+        {
+            write_gif_frame(src, row_pitch, is_bgr);
+        }
+        else
+        {
+            write_y4m_frame(src, row_pitch, is_bgr);
+        }
+        file_.flush();
+        frame_count_++;
+    }
+
+    void TimelapseWriter::init_palette(const char *rgba, const VkExtent3D &extent)
+    {
+        // median cut over a rgb555 histogram
+        std::vector<uint32_t> histogram(1 << 15, 0);
+        const uint8_t *pixels = reinterpret_cast<const uint8_t *>(rgba);
+        size_t pixel_count = static_cast<size_t>(extent.width) * extent.height;
+        for (size_t i = 0; i < pixel_count; i++)
+        {
+            const uint8_t *px = pixels + i * 4;
+            histogram[(px[0] >> 3) << 10 | (px[1] >> 3) << 5 | (px[2] >> 3)]++;
+        }
+        std::vector<uint16_t> colors;
+        for (uint32_t i = 0; i < histogram.size(); i++)
+        {
+            if (histogram[i] > 0)
+            {
+                colors.push_back(static_cast<uint16_t>(i));
+            }
+        }
+        auto channel = [](uint16_t color, int axis)
+        { return (color >> (10 - 5 * axis)) & 31; };
+
+        // [begin, end) of colors, the last palette entry is the white canvas
+        std::vector<std::pair<size_t, size_t>> boxes;
+        if (!colors.empty())
+        {
+            boxes.push_back({0, colors.size()});
+        }
+        while (boxes.size() < PALETTE_SIZE_ - 1)
+        {
+            int split = -1;
+            int split_axis = 0;
+            int split_range = 0;
+            for (size_t i = 0; i < boxes.size(); i++)
+            {
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    int lo = 31, hi = 0;
+                    for (size_t j = boxes[i].first; j < boxes[i].second; j++)
+                    {
+                        lo = std::min(lo, channel(colors[j], axis));
+                        hi = std::max(hi, channel(colors[j], axis));
+                    }
+                    if (hi - lo > split_range)
+                    {
+                        split = static_cast<int>(i);
+                        split_axis = axis;
+                        split_range = hi - lo;
+                    }
+                }
+            }
+            if (split < 0)
+            {
+                break;
+            }
+            auto [begin, end] = boxes[split];
+            std::sort(colors.begin() + begin, colors.begin() + end, [&](uint16_t a, uint16_t b)
+                      { return channel(a, split_axis) < channel(b, split_axis); });
+            uint64_t total = 0;
+            for (size_t j = begin; j < end; j++)
+            {
+                total += histogram[colors[j]];
+            }
+            uint64_t half = 0;
+            size_t median = begin + 1;
+            for (; median < end - 1; median++)
+            {
+                half += histogram[colors[median - 1]];
+                if (half * 2 >= total)
+                {
+                    break;
+                }
+            }
+            boxes[split] = {begin, median};
+            boxes.push_back({median, end});
+        }
+
+        palette_.assign(PALETTE_SIZE_ * 3, 0);
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            double sum[3] = {0.0, 0.0, 0.0};
+            double count = 0.0;
+            for (size_t j = boxes[i].first; j < boxes[i].second; j++)
+            {
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    sum[axis] += static_cast<double>(histogram[colors[j]]) * (channel(colors[j], axis) << 3 | 4);
+                }
+                count += histogram[colors[j]];
+            }
+            for (int axis = 0; axis < 3; axis++)
+            {
+                palette_[i * 3 + axis] = static_cast<uint8_t>(std::round(sum[axis] / count));
+            }
+        }
+        std::fill(palette_.end() - 3, palette_.end(), 255);
+        palette_cache_.assign(1 << 15, -1);
+    }
+
+    uint8_t TimelapseWriter::find_palette_index(uint8_t r, uint8_t g, uint8_t b)
+    {
+        int key = (r >> 3) << 10 | (g >> 3) << 5 | (b >> 3);
+        if (palette_cache_[key] >= 0)
+        {
+            return static_cast<uint8_t>(palette_cache_[key]);
+        }
+        int best = 0;
+        int best_distance = std::numeric_limits<int>::max();
+        for (int i = 0; i < PALETTE_SIZE_; i++)
+        {
+            int dr = palette_[i * 3] - r;
+            int dg = palette_[i * 3 + 1] - g;
+            int db = palette_[i * 3 + 2] - b;
+            int distance = dr * dr + dg * dg + db * db;
+            if (distance < best_distance)
+            {
+                best = i;
+                best_distance = distance;
+            }
+        }
+        palette_cache_[key] = static_cast<int16_t>(best);
+        return static_cast<uint8_t>(best);
+    }
+
+    void TimelapseWriter::write_gif_header()
+    {
+        file_.write("GIF89a", 6);
+        putShort(file_, static_cast<uint16_t>(extent_.width));
+        putShort(file_, static_cast<uint16_t>(extent_.height));
+        file_.put(static_cast<char>(0xf7)); // global color table, 8 bit, 256 entries
+        file_.put(0);                       // background index
+        file_.put(0);                       // aspect ratio
+        file_.write(reinterpret_cast<const char *>(palette_.data()), palette_.size());
+
+        // loop forever
+        file_.put(0x21);
+        file_.put(static_cast<char>(0xff));
+        file_.put(11);
+        file_.write("NETSCAPE2.0", 11);
+        file_.put(3);
+        file_.put(1);
+        putShort(file_, 0);
+        file_.put(0);
+    }
+
+    void TimelapseWriter::write_gif_frame(const char *src, VkDeviceSize row_pitch, bool is_bgr)
+    {
+        if (frame_count_ == 0)
+        {
+            if (palette_.empty())
+            {
+                std::vector<char> rgba(static_cast<size_t>(extent_.width) * extent_.height * 4);
+                for (uint32_t y = 0; y < extent_.height; y++)
+                {
+                    memcpy(rgba.data() + y * extent_.width * 4, src + y * row_pitch, extent_.width * 4);
+                }
+                init_palette(rgba.data(), extent_);
+            }
+            write_gif_header();
+        }
+        const int r = is_bgr ? 2 : 0;
+        const int b = is_bgr ? 0 : 2;
+        indices_.resize(static_cast<size_t>(extent_.width) * extent_.height);
+        for (uint32_t y = 0; y < extent_.height; y++)
+        {
+            const uint8_t *row = reinterpret_cast<const uint8_t *>(src + y * row_pitch);
+            uint8_t *dst = indices_.data() + y * extent_.width;
+            for (uint32_t x = 0; x < extent_.width; x++)
+            {
+                dst[x] = find_palette_index(row[4 * x + r], row[4 * x + 1], row[4 * x + b]);
+            }
+        }
+
+        // graphic control extension : frame delay in 1/100 s
+        file_.put(0x21);
+        file_.put(static_cast<char>(0xf9));
+        file_.put(4);
+        file_.put(0);
+        putShort(file_, static_cast<uint16_t>(100 / fps_));
+        file_.put(0);
+        file_.put(0);
+
+        // image descriptor, full frame, global color table
+        file_.put(0x2c);
+        putShort(file_, 0);
+        putShort(file_, 0);
+        putShort(file_, static_cast<uint16_t>(extent_.width));
+        putShort(file_, static_cast<uint16_t>(extent_.height));
+        file_.put(0);
+
+        const uint32_t MIN_CODE_SIZE = 8;
+        const uint32_t CLEAR_CODE = 1 << MIN_CODE_SIZE;
+        file_.put(static_cast<char>(MIN_CODE_SIZE));
+        LzwWriter writer(file_);
+
+        // (prefix code, index) -> code, only the written entries are cleared
+        static thread_local std::vector<int16_t> table(4096 * 256, -1);
+        std::vector<uint32_t> used;
+        auto clear_table = [&]()
+        {
+            for (uint32_t key : used)
+            {
+                table[key] = -1;
+            }
+            used.clear();
+        };
+
+        uint32_t code_size = MIN_CODE_SIZE + 1;
+        uint32_t max_code = CLEAR_CODE + 1;
+        writer.write_code(CLEAR_CODE, code_size);
+        uint32_t code = indices_[0];
+        for (size_t i = 1; i < indices_.size(); i++)
+        {
+            uint32_t key = code * 256 + indices_[i];
+            if (table[key] >= 0)
+            {
+                code = static_cast<uint32_t>(table[key]);
+                continue;
+            }
+            writer.write_code(code, code_size);
+            max_code++;
+            table[key] = static_cast<int16_t>(max_code);
+            used.push_back(key);
+            if (max_code >= (1u << code_size))
+            {
+                code_size++;
+            }
+            if (max_code == 4095)
+            {
+                writer.write_code(CLEAR_CODE, code_size);
+                clear_table();
+                code_size = MIN_CODE_SIZE + 1;
+                max_code = CLEAR_CODE + 1;
+            }
+            code = indices_[i];
+        }
+        writer.write_code(code, code_size);
+        // the decoder adds an entry for the last code (unless it follows a clear) : EOI is read at its width
+        if (max_code > CLEAR_CODE + 1)
+        {
+            max_code++;
+            if (max_code >= (1u << code_size) && code_size < 12)
+            {
+                code_size++;
+            }
+        }
+        writer.write_code(CLEAR_CODE + 1, code_size);
+        writer.finish();
+        clear_table();
+    }
+
+    void TimelapseWriter::write_y4m_frame(const char *src, VkDeviceSize row_pitch, bool is_bgr)
+    {
+        // bt.601 limited range, full resolution chroma
+        const int r_idx = is_bgr ? 2 : 0;
+        const int b_idx = is_bgr ? 0 : 2;
+        size_t plane_size = static_cast<size_t>(extent_.width) * extent_.height;
+        planes_.resize(plane_size * 3);
+        uint8_t *y_plane = planes_.data();
+        uint8_t *u_plane = y_plane + plane_size;
+        uint8_t *v_plane = u_plane + plane_size;
+        for (uint32_t y = 0; y < extent_.height; y++)
+        {
+            const uint8_t *row = reinterpret_cast<const uint8_t *>(src + y * row_pitch);
+            for (uint32_t x = 0; x < extent_.width; x++)
+            {
+                int r = row[4 * x + r_idx];
+                int g = row[4 * x + 1];
+                int b = row[4 * x + b_idx];
+                size_t i = static_cast<size_t>(y) * extent_.width + x;
+                y_plane[i] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+                u_plane[i] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                v_plane[i] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+        }
+        file_.write("FRAME\n", 6);
+        file_.write(reinterpret_cast<const char *>(planes_.data()), planes_.size());
+    }
+} // namespace vkcpp
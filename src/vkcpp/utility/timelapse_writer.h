@@ -0,0 +1,72 @@
+#ifndef VKCPP_UTILITY_TIMELAPSE_WRITER_H
+#define VKCPP_UTILITY_TIMELAPSE_WRITER_H
+
+#include "vulkan_header.h"
+
+namespace vkcpp
+{
+    /**
+     *  Streaming time-lapse : animated gif (.gif) or raw yuv 4:4:4 (.y4m, for an external encoder).
+     *  Every frame is written when it is added, memory does not grow with the frame count.
+     */
+    class TimelapseWriter
+    {
+    private:
+        static const int PALETTE_SIZE_ = 256;
+
+        std::ofstream file_;
+
+        VkExtent3D extent_{};
+
+        uint32_t fps_{10};
+
+        bool is_gif_{true};
+
+        uint64_t frame_count_{0};
+
+        // rgb, computed once
+        std::vector<uint8_t> palette_;
+
+        // rgb555 -> palette index (-1 : not cached)
+        std::vector<int16_t> palette_cache_;
+
+        // frame buffers reused by every frame
+        std::vector<uint8_t> indices_;
+
+        std::vector<uint8_t> planes_;
+
+        void init_palette(const char *rgba, const VkExtent3D &extent);
+
+        uint8_t find_palette_index(uint8_t r, uint8_t g, uint8_t b);
+
+        void write_gif_header();
+
+        void write_gif_frame(const char *src, VkDeviceSize row_pitch, bool is_bgr);
+
+        void write_y4m_frame(const char *src, VkDeviceSize row_pitch, bool is_bgr);
+
+    public:
+        /**
+         *  @param palette_source rgba image the gif palette is cut from (target), nullptr : first frame
+         */
+        TimelapseWriter(const std::string &filename, const VkExtent3D &extent, uint32_t fps, const char *palette_source = nullptr);
+
+        TimelapseWriter(const TimelapseWriter &) = delete;
+
+        ~TimelapseWriter();
+
+        const uint64_t get_frame_count() const { return frame_count_; }
+
+        /**
+         *  @param format rgba or bgra 8 bit
+         */
+        void add_frame(const char *src, VkDeviceSize row_pitch, VkFormat format);
+
+        /**
+         *  @brief write the trailer, later frames are ignored
+         */
+        void close();
+    }; // class TimelapseWriter
+} // namespace vkcpp
+
+#endif // #ifndef VKCPP_UTILITY_TIMELAPSE_WRITER_H
@@ -0,0 +1,79 @@
+#include "trace.h"
+
+#ifdef VKCPP_ENABLE_TRACE
+
+namespace vkcpp
+{
+    Tracer::Tracer()
+        : origin_(std::chrono::steady_clock::now())
+    {
+    }
+
+    Tracer::ThreadBuffer::ThreadBuffer()
+        : buffer(Tracer::getInstance()->register_thread())
+    {
+    }
+
+    Tracer::ThreadBuffer::~ThreadBuffer()
+    {
+        Tracer::getInstance()->release_thread(buffer);
+    }
+
+    TraceBuffer *Tracer::register_thread()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_buffers_.empty())
+        {
+            TraceBuffer *buffer = free_buffers_.back();
+            free_buffers_.pop_back();
+            return buffer;
+        }
+        auto buffer = std::make_shared<TraceBuffer>();
+        buffer->tid = static_cast<uint32_t>(buffers_.size());
+        buffers_.push_back(buffer);
+        return buffer.get();
+    }
+
+    void Tracer::release_thread(TraceBuffer *buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_buffers_.push_back(buffer);
+    }
+
+    TraceBuffer *Tracer::get_thread_buffer()
+    {
+        thread_local ThreadBuffer thread_buffer;
+        return thread_buffer.buffer;
+    }
+
+    void Tracer::dump(const std::string &filename)
+    {
+        std::ofstream out(filename, std::ios::out | std::ios::trunc);
+        if (!out.is_open())
+        {
+            throw std::runtime_error("failed to open trace output!");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        out << "{\"traceEvents\":[";
+        bool is_first = true;
+        for (auto &buffer : buffers_)
+        {
+            for (auto &event : buffer->events)
+            {
+                if (!is_first)
+                {
+                    out << ",\n";
+                }
+                is_first = false;
+                out << "{\"name\":\"" << event.name
+                    << "\",\"cat\":\"vkcpp\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->tid
+                    << ",\"ts\":" << event.begin_us
+                    << ",\"dur\":" << event.duration_us << "}";
+            }
+        }
+        out << "],\"displayTimeUnit\":\"ms\"}\n";
+    }
+} // namespace vkcpp
+
+#endif // #ifdef VKCPP_ENABLE_TRACE
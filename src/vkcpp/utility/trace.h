@@ -0,0 +1,121 @@
+#ifndef VKCPP_UTILITY_TRACE_H
+#define VKCPP_UTILITY_TRACE_H
+
+/**
+ *  Chrome trace_event (Perfetto) timeline.
+ *  Build with VKCPP_ENABLE_TRACE, otherwise the macros expand to nothing.
+ *
+ *  VKCPP_TRACE_SCOPE("name")   : complete event for the enclosing scope
+ *  VKCPP_TRACE_DUMP("a.json")  : write every recorded event (call after the worker threads are joined)
+ */
+#ifdef VKCPP_ENABLE_TRACE
+
+#include "pattern/singleton.hpp"
+#include "stdafx.h"
+
+namespace vkcpp
+{
+    struct TraceEvent
+    {
+        // string literal
+        const char *name;
+        // microseconds from the trace origin
+        int64_t begin_us;
+        int64_t duration_us;
+    };
+
+    /**
+     *  Event buffer of a thread. Only the owner thread appends, no lock.
+     *  Released when the thread exits and reused by the next new thread (same tid).
+     */
+    struct TraceBuffer
+    {
+        uint32_t tid{0};
+        std::vector<TraceEvent> events;
+    };
+
+    class Tracer : public Singleton<Tracer>
+    {
+        // before any worker thread asks for the instance
+        inline static const bool is_instanced_ = initInstance();
+
+    private:
+        // owned by a thread_local : the buffer is released when its thread exits
+        struct ThreadBuffer
+        {
+            TraceBuffer *buffer;
+
+            ThreadBuffer();
+
+            ~ThreadBuffer();
+        };
+
+        // registration only
+        std::mutex mutex_;
+
+        // kept alive after the thread exits
+        std::vector<std::shared_ptr<TraceBuffer>> buffers_;
+
+        // buffers of exited threads (short lived threads, e.g. islands, reuse them)
+        std::vector<TraceBuffer *> free_buffers_;
+
+        std::chrono::steady_clock::time_point origin_;
+
+        TraceBuffer *register_thread();
+
+        void release_thread(TraceBuffer *buffer);
+
+    public:
+        Tracer();
+
+        Tracer(const Tracer &) = delete;
+
+        virtual ~Tracer() = default;
+
+        const std::chrono::steady_clock::time_point &get_origin() const { return origin_; }
+
+        TraceBuffer *get_thread_buffer();
+
+        void dump(const std::string &filename);
+    }; // class Tracer
+
+    class TraceScope
+    {
+    private:
+        const char *name_;
+
+        std::chrono::steady_clock::time_point begin_;
+
+    public:
+        explicit TraceScope(const char *name)
+            : name_(name), begin_(std::chrono::steady_clock::now())
+        {
+        }
+
+        TraceScope(const TraceScope &) = delete;
+
+        ~TraceScope()
+        {
+            auto end = std::chrono::steady_clock::now();
+            const auto &origin = Tracer::getInstance()->get_origin();
+            Tracer::getInstance()->get_thread_buffer()->events.push_back(
+                {name_,
+                 std::chrono::duration_cast<std::chrono::microseconds>(begin_ - origin).count(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(end - begin_).count()});
+        }
+    }; // class TraceScope
+} // namespace vkcpp
+
+#define VKCPP_TRACE_CONCAT_IMPL(a, b) a##b
+#define VKCPP_TRACE_CONCAT(a, b) VKCPP_TRACE_CONCAT_IMPL(a, b)
+#define VKCPP_TRACE_SCOPE(name) vkcpp::TraceScope VKCPP_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define VKCPP_TRACE_DUMP(filename) vkcpp::Tracer::getInstance()->dump(filename)
+
+#else
+
+#define VKCPP_TRACE_SCOPE(name)
+#define VKCPP_TRACE_DUMP(filename)
+
+#endif // #ifdef VKCPP_ENABLE_TRACE
+
+#endif // #ifndef VKCPP_UTILITY_TRACE_H
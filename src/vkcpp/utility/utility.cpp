@@ -17,6 +17,14 @@ namespace vkcpp
     {
         return getRandFloat(0.0f, 1.0f);
     }
+    float getRandFloat(std::mt19937 &engine, float lo, float hi)
+    {
+        return lo + std::generate_canonical<float, 24>(engine) * (hi - lo);
+    }
+    float getProbablity(std::mt19937 &engine)
+    {
+        return getRandFloat(engine, 0.0f, 1.0f);
+    }
     std::vector<char> readFile(const std::string &filename)
     {
         std::ifstream file(filename, std::ios::ate | std::ios::binary);
@@ -3,11 +3,16 @@
 
 #include "vulkan_header.h"
 
+#include <random>
+
 namespace vkcpp
 {
     void VK_CHECK_RESULT(VkBool32 a);
     float getRandFloat(float lo, float hi);
     float getProbablity();
+    // engine of the caller (one per thread) : rand() is shared
+    float getRandFloat(std::mt19937 &engine, float lo, float hi);
+    float getProbablity(std::mt19937 &engine);
     std::vector<char> readFile(const std::string &filename);
 } // namespace vkcpp
 